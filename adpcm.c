@@ -0,0 +1,117 @@
+#include "lib/adpcm.h"  // Codificação IMA-ADPCM 4:1
+
+// Passos do quantizador (tabela padrão do IMA-ADPCM, ~1,1x entre vizinhos)
+static const int16_t passos[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767};
+
+// Ajuste do índice do passo pela magnitude do código
+static const int8_t ajuste_indice[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+/**
+ * Zera o estado: preditor em 0 e o menor passo.
+ */
+void adpcm_iniciar(adpcm_estado_t *estado) {
+    estado->predito = 0;
+    estado->indice = 0;
+}
+
+/**
+ * Aplica um código de 4 bits ao preditor e ao índice; é o passo comum ao
+ * codificador e ao decodificador, o que os mantém em sincronia.
+ */
+static inline __attribute__((always_inline))
+void adpcm_passo(int32_t *predito, int32_t *indice, uint32_t codigo) {
+    int32_t passo = passos[*indice];
+    int32_t delta = passo >> 3;
+    if (codigo & 4)
+        delta += passo;
+    if (codigo & 2)
+        delta += passo >> 1;
+    if (codigo & 1)
+        delta += passo >> 2;
+
+    int32_t p = (codigo & 8) ? *predito - delta : *predito + delta;
+    *predito = p > INT16_MAX ? INT16_MAX : p < INT16_MIN ? INT16_MIN : p;
+
+    int32_t i = *indice + ajuste_indice[codigo & 7];
+    *indice = i < 0 ? 0 : i > 88 ? 88 : i;
+}
+
+/**
+ * Quantiza uma amostra em 4 bits contra o preditor atual e atualiza o estado.
+ */
+static inline __attribute__((always_inline))
+uint32_t adpcm_codificar(int32_t *predito, int32_t *indice, int32_t x) {
+    int32_t diferenca = x - *predito;
+    uint32_t codigo = 0;
+    if (diferenca < 0) {
+        codigo = 8;
+        diferenca = -diferenca;
+    }
+
+    // Divisão de diferenca pelo passo em 3 bits, por aproximações sucessivas
+    int32_t passo = passos[*indice];
+    if (diferenca >= passo) {
+        codigo |= 4;
+        diferenca -= passo;
+    }
+    passo >>= 1;
+    if (diferenca >= passo) {
+        codigo |= 2;
+        diferenca -= passo;
+    }
+    passo >>= 1;
+    if (diferenca >= passo)
+        codigo |= 1;
+
+    adpcm_passo(predito, indice, codigo);
+    return codigo;
+}
+
+/**
+ * Codifica n amostras (n par) em saida: cabeçalho com o estado atual e n/2
+ * bytes de códigos. Retorna os bytes escritos (ADPCM_BYTES_BLOCO(n)).
+ */
+uint adpcm_codificar_bloco(adpcm_estado_t *estado, const int16_t *amostras, uint n, uint8_t *saida) {
+    int32_t predito = estado->predito, indice = estado->indice;
+    saida[0] = (uint8_t)predito;
+    saida[1] = (uint8_t)((uint16_t)predito >> 8);
+    saida[2] = (uint8_t)indice;
+    saida[3] = 0;
+
+    uint8_t *p = &saida[ADPCM_CABECALHO];
+    for (uint i = 0; i < n; i += 2) {
+        uint32_t baixo = adpcm_codificar(&predito, &indice, amostras[i]);
+        uint32_t alto = adpcm_codificar(&predito, &indice, amostras[i + 1]);
+        *p++ = (uint8_t)(baixo | (alto << 4));
+    }
+
+    estado->predito = (int16_t)predito;
+    estado->indice = (uint8_t)indice;
+    return ADPCM_BYTES_BLOCO(n);
+}
+
+/**
+ * Decodifica um bloco de n amostras gravado por adpcm_codificar_bloco.
+ * Retorna os bytes consumidos.
+ */
+uint adpcm_decodificar_bloco(const uint8_t *entrada, uint n, int16_t *amostras) {
+    int32_t predito = (int16_t)(entrada[0] | (entrada[1] << 8));
+    int32_t indice = entrada[2] > 88 ? 88 : entrada[2];
+
+    const uint8_t *p = &entrada[ADPCM_CABECALHO];
+    for (uint i = 0; i < n; i += 2) {
+        uint32_t byte = *p++;
+        adpcm_passo(&predito, &indice, byte & 0xF);
+        amostras[i] = (int16_t)predito;
+        adpcm_passo(&predito, &indice, byte >> 4);
+        amostras[i + 1] = (int16_t)predito;
+    }
+    return ADPCM_BYTES_BLOCO(n);
+}
@@ -0,0 +1,167 @@
+#include "lib/agendador.h"  // Agendador cooperativo do núcleo 0
+#include <stdio.h>
+
+static agendador_tarefa_t tarefas[AGENDADOR_MAX_TAREFAS];
+static uint num_tarefas = 0;
+
+// Tempo dormindo em __wfe() e início da janela do relatório
+static uint64_t ocioso_us = 0;
+static uint64_t janela_inicio_us = 0;
+
+// Alguma tarefa liberada por agendador_liberar() desde a última escolha
+static volatile bool liberacao_pendente = false;
+
+// Gancho das esperas entre tarefas de pelo menos ocioso_minimo_us
+static agendador_ocioso_t ocioso_funcao = NULL;
+static uint32_t ocioso_minimo_us = 0;
+
+/**
+ * Registra uma tarefa periódica; a primeira execução é imediata.
+ * Retorna o índice da tarefa ou -1 se não houver espaço.
+ */
+int agendador_adicionar(const char *nome, uint32_t periodo_ms, agendador_funcao_t funcao) {
+    if (num_tarefas >= AGENDADOR_MAX_TAREFAS)
+        return -1;
+    tarefas[num_tarefas] = (agendador_tarefa_t){
+        .nome = nome,
+        .funcao = funcao,
+        .periodo_us = periodo_ms * 1000,
+        .liberacao_us = time_us_64(),
+    };
+    return (int)num_tarefas++;
+}
+
+/**
+ * Muda o período de uma tarefa; vale a partir da próxima liberação.
+ */
+void agendador_set_periodo(int tarefa, uint32_t periodo_ms) {
+    if (tarefa >= 0 && (uint)tarefa < num_tarefas)
+        tarefas[tarefa].periodo_us = periodo_ms * 1000;
+}
+
+/**
+ * Libera a tarefa para rodar já, sem mudar a fase do período. Pode ser
+ * chamada de interrupções do núcleo 0: acorda a espera do agendador.
+ */
+void agendador_liberar(int tarefa) {
+    if (tarefa < 0 || (uint)tarefa >= num_tarefas)
+        return;
+    tarefas[tarefa].liberada = true;
+    liberacao_pendente = true;
+    __sev();
+}
+
+/**
+ * Dorme (__wfe) por duracao_us, contando o tempo como ocioso. Qualquer
+ * evento acorda o núcleo, que volta a dormir até o fim do prazo.
+ * É a espera usada por timer_seconds() e timer_milliseconds().
+ */
+void agendador_dormir_us(uint64_t duracao_us) {
+    uint64_t inicio = time_us_64();
+    absolute_time_t fim = from_us_since_boot(inicio + duracao_us);
+    while (!best_effort_wfe_or_timeout(fim))
+        ;
+    ocioso_us += time_us_64() - inicio;
+}
+
+/**
+ * Espera do agendador entre tarefas: como agendador_dormir_us(), mas
+ * termina antes se uma tarefa for liberada por agendador_liberar().
+ */
+static void esperar_liberacao(uint64_t duracao_us) {
+    uint64_t inicio = time_us_64();
+    absolute_time_t fim = from_us_since_boot(inicio + duracao_us);
+    while (!liberacao_pendente && !best_effort_wfe_or_timeout(fim))
+        ;
+    ocioso_us += time_us_64() - inicio;
+}
+
+/**
+ * Registra uma função chamada antes e depois das esperas entre tarefas de
+ * pelo menos minimo_us (ex.: baixar o clock). Não vale para as esperas
+ * dentro das tarefas.
+ */
+void agendador_set_ocioso(uint32_t minimo_us, agendador_ocioso_t funcao) {
+    ocioso_minimo_us = minimo_us;
+    ocioso_funcao = funcao;
+}
+
+/**
+ * Roda as tarefas para sempre: a cada volta, executa a tarefa liberada de
+ * prazo mais próximo; sem nenhuma liberada, dorme até a próxima liberação.
+ */
+void agendador_executar() {
+    janela_inicio_us = time_us_64();
+    while (true) {
+        liberacao_pendente = false;
+        uint64_t agora = time_us_64();
+        agendador_tarefa_t *escolhida = NULL;
+        uint64_t prazo_escolhida = 0;
+        uint64_t proxima_liberacao = UINT64_MAX;
+
+        for (uint i = 0; i < num_tarefas; ++i) {
+            agendador_tarefa_t *t = &tarefas[i];
+            if (t->liberada || t->liberacao_us <= agora) {
+                uint64_t prazo = t->liberada ? agora : t->liberacao_us + t->periodo_us;
+                if (escolhida == NULL || prazo < prazo_escolhida) {
+                    escolhida = t;
+                    prazo_escolhida = prazo;
+                }
+            } else if (t->liberacao_us < proxima_liberacao) {
+                proxima_liberacao = t->liberacao_us;
+            }
+        }
+
+        if (escolhida == NULL) {
+            bool longa = ocioso_funcao != NULL && proxima_liberacao - agora >= ocioso_minimo_us;
+            if (longa)
+                ocioso_funcao(true);
+            esperar_liberacao(proxima_liberacao - agora);
+            if (longa)
+                ocioso_funcao(false);
+            continue;
+        }
+
+        bool periodica = escolhida->liberacao_us <= agora;
+        escolhida->liberada = false;  // Liberações durante a execução valem para a próxima
+        escolhida->funcao();
+        uint64_t fim = time_us_64();
+        uint32_t duracao = (uint32_t)(fim - agora);
+        escolhida->execucoes++;
+        escolhida->tempo_us += duracao;
+        if (duracao > escolhida->tempo_max_us)
+            escolhida->tempo_max_us = duracao;
+
+        // Mantém a fase: liberações que já passaram são perdidas, não acumuladas
+        if (!periodica)
+            continue;
+        escolhida->liberacao_us += escolhida->periodo_us;
+        while (escolhida->liberacao_us <= fim) {
+            escolhida->liberacao_us += escolhida->periodo_us;
+            escolhida->atrasos++;
+        }
+    }
+}
+
+/**
+ * Imprime o tempo ocioso e, por tarefa, execuções, atrasos e tempo de
+ * execução desde o relatório anterior, e zera os contadores.
+ */
+void agendador_relatorio() {
+    uint64_t agora = time_us_64();
+    uint64_t janela = agora - janela_inicio_us;
+    if (janela == 0)
+        return;
+
+    printf("[AGENDADOR] Ocioso: %.1f%% em %.1f s\n", 100.f * ocioso_us / janela, janela / 1e6f);
+    for (uint i = 0; i < num_tarefas; ++i) {
+        agendador_tarefa_t *t = &tarefas[i];
+        printf("[AGENDADOR] %-10s %4u ms: %5u execucoes, %3u atrasos, media %5u us, max %6u us, carga %.1f%%\n",
+               t->nome, (unsigned)(t->periodo_us / 1000), (unsigned)t->execucoes, (unsigned)t->atrasos,
+               (unsigned)(t->execucoes ? t->tempo_us / t->execucoes : 0), (unsigned)t->tempo_max_us,
+               100.f * t->tempo_us / janela);
+        t->execucoes = t->atrasos = t->tempo_us = t->tempo_max_us = 0;
+    }
+    ocioso_us = 0;
+    janela_inicio_us = agora;
+}
@@ -0,0 +1,509 @@
+#include <stdio.h>
+#include "lib/benchmark.h"
+#include "lib/microfone.h"
+#include "lib/decimador.h"
+#include "lib/decibel.h"
+#include "lib/ponderacao.h"
+#include "lib/espectro.h"
+#include "lib/microfonia.h"
+#include "lib/adpcm.h"
+#include "lib/registro.h"
+#include "lib/display_oled.h"
+#include "lib/texto.h"
+#include "hardware/structs/systick.h"  // SysTick como contador de ciclos (o M0+ não tem DWT)
+#include "hardware/sync.h"
+#include "hardware/clocks.h"
+
+#define BENCH_REPETICOES 16  // Blocos processados por medição de tempo
+
+/**
+ * Configura o SysTick para contar ciclos do processador livremente.
+ */
+void ciclos_iniciar() {
+    systick_hw->csr = 0;
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;  // Habilita, fonte = clock do processador, sem interrupção
+}
+
+/**
+ * Retorna o valor atual do contador (decrescente).
+ */
+uint32_t ciclos_agora() {
+    return systick_hw->cvr;
+}
+
+/**
+ * Retorna os ciclos decorridos desde uma leitura de ciclos_agora().
+ */
+uint32_t ciclos_desde(uint32_t inicio) {
+    return (inicio - systick_hw->cvr) & 0x00FFFFFF;
+}
+
+/**
+ * Imprime o custo por amostra em centésimos de ciclo.
+ */
+static void bench_imprime(const char *nome, uint32_t ciclos, uint32_t amostras) {
+    uint32_t centesimos = (uint32_t)((uint64_t)ciclos * 100 / amostras);
+    printf("[BENCH] %-28s %lu.%02lu ciclos/amostra\n", nome,
+           (unsigned long)(centesimos / 100), (unsigned long)(centesimos % 100));
+}
+
+/**
+ * Gera um bloco de teste amostrado na taxa dada: senoide de 1 kHz com
+ * ruído em torno do bias.
+ */
+static void bench_gera_bloco(uint16_t *bloco, uint n, uint32_t taxa) {
+    uint32_t semente = 12345;
+    for (uint i = 0; i < n; ++i) {
+        semente = semente * 1664525u + 1013904223u;  // LCG
+        int32_t ruido = (int32_t)(semente >> 26) - 32;
+        int32_t seno = (int32_t)(600.f * sinf(2.f * (float)M_PI * 1000.f * i / taxa));
+        bloco[i] = (uint16_t)(ADC_BIAS_CODE + seno + ruido);
+    }
+}
+
+/**
+ * Compara o RMS em ponto flutuante (mic_power) com o kernel inteiro.
+ */
+static void benchmark_rms() {
+    static uint16_t bloco[SAMPLES];
+    bench_gera_bloco(bloco, SAMPLES, AUDIO_SAMPLE_RATE);
+
+    volatile float rms_float = 0.f;
+    volatile uint32_t rms_q8 = 0;
+
+    uint32_t status = save_and_disable_interrupts();
+
+    uint32_t inicio = ciclos_agora();
+    for (int r = 0; r < BENCH_REPETICOES; ++r)
+        rms_float = mic_power(bloco, SAMPLES);
+    uint32_t ciclos_float = ciclos_desde(inicio);
+
+    inicio = ciclos_agora();
+    for (int r = 0; r < BENCH_REPETICOES; ++r)
+        rms_q8 = mic_power_fixed(bloco, SAMPLES);
+    uint32_t ciclos_fixo = ciclos_desde(inicio);
+
+    restore_interrupts(status);
+
+    bench_imprime("mic_power (float)", ciclos_float, BENCH_REPETICOES * SAMPLES);
+    bench_imprime("mic_power_fixed (inteiro)", ciclos_fixo, BENCH_REPETICOES * SAMPLES);
+    printf("[BENCH] RMS float (com DC): %.2f, RMS inteiro (sem DC): %.2f codigos\n",
+           rms_float, rms_q8 / 256.f);
+}
+
+/**
+ * Mede a passada única de decimação + energia + pico + saturação e o true
+ * peak, contra a decimação e a energia em passadas separadas, e o custo da
+ * decimação em relação ao clock do sistema.
+ */
+static void benchmark_picos() {
+    static uint16_t bloco[ADC_SAMPLES_BLOCO];
+    static int32_t amostras[SAMPLES];
+    static decimador_t decimador;
+    bench_gera_bloco(bloco, ADC_SAMPLES_BLOCO, ADC_CAPTURE_RATE);
+    decimador_init(&decimador, DECIMACAO_FATOR);
+
+    // O bloco tem um número inteiro de períodos: repetido, é um sinal contínuo
+    // e os dois decimadores chegam ao mesmo estado depois da primeira volta
+    // (sem as correções, que o decimador local não aplica)
+    mic_set_correcoes(false, false);
+    volatile uint64_t energia = 0;
+    mic_bloco_info_t info;
+    uint32_t saturadas_min = 0, saturadas_max = 0;
+    uint32_t ciclos_decimador = 0, ciclos_separado = 0, ciclos_unico = 0, ciclos_tp = 0;
+
+    uint32_t status = save_and_disable_interrupts();
+    for (int r = 0; r < BENCH_REPETICOES; ++r) {
+        uint32_t inicio = ciclos_agora();
+        decimador_processar(&decimador, bloco, ADC_SAMPLES_BLOCO, amostras, &saturadas_min, &saturadas_max);
+        ciclos_decimador += ciclos_desde(inicio);
+        energia = mic_energy_samples(amostras, SAMPLES);
+        ciclos_separado += ciclos_desde(inicio);
+
+        inicio = ciclos_agora();
+        mic_analisar_bloco(bloco, ADC_SAMPLES_BLOCO, amostras, NULL, &info);
+        ciclos_unico += ciclos_desde(inicio);
+
+        inicio = ciclos_agora();
+        mic_true_peak(amostras, SAMPLES, info.pico);
+        ciclos_tp += ciclos_desde(inicio);
+    }
+    restore_interrupts(status);
+
+    bench_imprime("decimador (por amostra ADC)", ciclos_decimador, BENCH_REPETICOES * ADC_SAMPLES_BLOCO);
+    bench_imprime("decima + energia", ciclos_separado, BENCH_REPETICOES * SAMPLES);
+    bench_imprime("mic_analisar_bloco", ciclos_unico, BENCH_REPETICOES * SAMPLES);
+    bench_imprime("mic_true_peak", ciclos_tp, BENCH_REPETICOES * SAMPLES);
+
+    uint32_t ciclos_segundo = ciclos_decimador / BENCH_REPETICOES * AUDIO_BLOCOS_POR_SEGUNDO;
+    printf("[BENCH] Decimacao %u:1: %lu ciclos por segundo de audio (%.1f%% do clk_sys)\n",
+           (unsigned)DECIMACAO_FATOR, (unsigned long)ciclos_segundo,
+           100.f * ciclos_segundo / clock_get_hz(clk_sys));
+    printf("[BENCH] Energia da passada unica %s a das passadas separadas\n",
+           energia == info.energia ? "igual" : "DIFERENTE");
+    mic_set_correcoes(MIC_LINEARIZAR_PADRAO, MIC_REMOVER_DC_PADRAO);
+}
+
+/**
+ * Mede o custo das ponderações A e C no formato interno de áudio.
+ * O orçamento de tempo real é clk_sys / AUDIO_SAMPLE_RATE ciclos por amostra
+ * no núcleo 1 (~2600 a 125 MHz e 48 kHz).
+ */
+static void benchmark_ponderacao() {
+    static uint16_t bloco[SAMPLES];
+    static int32_t amostras[SAMPLES];
+    bench_gera_bloco(bloco, SAMPLES, AUDIO_SAMPLE_RATE);
+
+    const ponderacao_freq_t tipos[] = {PONDERACAO_A, PONDERACAO_C};
+    for (uint t = 0; t < count_of(tipos); ++t) {
+        filtro_ponderacao_t filtro;
+        ponderacao_init(&filtro, tipos[t], AUDIO_SAMPLE_RATE);
+
+        uint32_t ciclos = 0;
+        uint32_t status = save_and_disable_interrupts();
+        for (int r = 0; r < BENCH_REPETICOES; ++r) {
+            mic_convert_block(bloco, amostras, SAMPLES);  // Fora da medição
+            uint32_t inicio = ciclos_agora();
+            ponderacao_processar(&filtro, amostras, SAMPLES);
+            ciclos += ciclos_desde(inicio);
+        }
+        restore_interrupts(status);
+
+        char nome[32];
+        snprintf(nome, sizeof(nome), "ponderacao %s", ponderacao_nome(tipos[t]));
+        bench_imprime(nome, ciclos, BENCH_REPETICOES * SAMPLES);
+    }
+}
+
+/**
+ * Mede a FFT radix-4 (ciclos por quadro), o custo total do analisador
+ * (janela + FFT + bandas) por amostra e o detector de microfonia por quadro.
+ */
+static void benchmark_espectro() {
+    static espectro_t espectro;
+    static uint16_t bloco[SAMPLES];
+    static int32_t amostras[SAMPLES];
+    bench_gera_bloco(bloco, SAMPLES, AUDIO_SAMPLE_RATE);
+    mic_convert_block(bloco, amostras, SAMPLES);
+    espectro_init(&espectro, AUDIO_SAMPLE_RATE);
+
+    // FFT isolada sobre um quadro já janelado
+    espectro_adicionar(&espectro, amostras, SAMPLES);
+    uint32_t status = save_and_disable_interrupts();
+    uint32_t inicio = ciclos_agora();
+    fft_radix4_q15(espectro.dados);
+    uint32_t ciclos_fft = ciclos_desde(inicio);
+    restore_interrupts(status);
+    printf("[BENCH] %-28s %lu ciclos/quadro (%u pontos)\n", "fft_radix4_q15",
+           (unsigned long)ciclos_fft, ESPECTRO_N);
+
+    // Analisador completo ao longo de vários quadros
+    espectro_reiniciar(&espectro);
+    uint32_t ciclos = 0, total = 0;
+    status = save_and_disable_interrupts();
+    while (total < 4 * ESPECTRO_N) {
+        inicio = ciclos_agora();
+        espectro_adicionar(&espectro, amostras, SAMPLES);
+        ciclos += ciclos_desde(inicio);
+        total += SAMPLES;
+    }
+    restore_interrupts(status);
+    bench_imprime("espectro (janela+fft+bandas)", ciclos, total);
+
+    // Detector de microfonia sobre o último quadro (roda uma vez por quadro)
+    static microfonia_t microfonia;
+    microfonia_evento_t eventos[MICROFONIA_CANDIDATOS];
+    microfonia_init(&microfonia, AUDIO_SAMPLE_RATE);
+    ciclos = 0;
+    status = save_and_disable_interrupts();
+    for (uint r = 0; r < BENCH_REPETICOES; ++r) {
+        inicio = ciclos_agora();
+        microfonia_quadro(&microfonia, espectro.potencia, espectro.expoente, eventos);
+        ciclos += ciclos_desde(inicio);
+    }
+    restore_interrupts(status);
+    printf("[BENCH] %-28s %lu ciclos/quadro\n", "microfonia_quadro",
+           (unsigned long)(ciclos / BENCH_REPETICOES));
+}
+
+/**
+ * Custo e efeito das correções da captura: mic_analisar_bloco com cada
+ * combinação de linearização e remoção do DC sobre um tom de 1 kHz com
+ * 40 códigos de DC a mais, e o erro do nível medido em relação ao do tom.
+ */
+static void benchmark_correcoes() {
+    static uint16_t bloco[ADC_SAMPLES_BLOCO];
+    static int32_t amostras[SAMPLES];
+    bench_gera_bloco(bloco, ADC_SAMPLES_BLOCO, ADC_CAPTURE_RATE);
+    for (uint i = 0; i < ADC_SAMPLES_BLOCO; ++i)
+        bloco[i] += 40;
+
+    // Tom de 600 códigos de pico: média quadrática esperada no formato interno
+    const float esperado = 600.f * 600.f / 2.f * (1 << (2 * AUDIO_FRAC_BITS));
+    static const char *nomes[4] = {"sem correcoes", "linearizacao", "remocao do DC", "as duas"};
+
+    for (uint modo = 0; modo < 4; ++modo) {
+        mic_set_correcoes(modo & 1, modo & 2);
+        mic_bloco_info_t info;
+
+        // Blocos de aquecimento: o DC acompanhado converge em ~10 blocos
+        for (uint r = 0; r < 50; ++r)
+            mic_analisar_bloco(bloco, ADC_SAMPLES_BLOCO, amostras, NULL, &info);
+
+        uint32_t ciclos = 0;
+        uint32_t status = save_and_disable_interrupts();
+        for (uint r = 0; r < BENCH_REPETICOES; ++r) {
+            uint32_t inicio = ciclos_agora();
+            mic_analisar_bloco(bloco, ADC_SAMPLES_BLOCO, amostras, NULL, &info);
+            ciclos += ciclos_desde(inicio);
+        }
+        restore_interrupts(status);
+
+        float erro = 10.f * log10f((float)info.energia / SAMPLES / esperado);
+        printf("[BENCH] Correcoes (%s): %lu ciclos/bloco, erro do nivel %+.3f dB\n",
+               nomes[modo], (unsigned long)(ciclos / BENCH_REPETICOES), erro);
+    }
+    mic_set_correcoes(MIC_LINEARIZAR_PADRAO, MIC_REMOVER_DC_PADRAO);
+}
+
+/**
+ * Referência com log10f: a versão anterior de calculate_db().
+ */
+static float bench_db_log10f(float voltage) {
+    return 20.0f * log10f(voltage / 0.0001f);
+}
+
+/**
+ * Compara a conversão para dB com log10f contra as versões em ponto fixo
+ * (ciclos por conversão) e varre todas as amplitudes do ADC no formato
+ * interno comparando potencia_para_mdb com log10 em double.
+ */
+static void benchmark_decibel() {
+    static float tensoes[64];
+    static uint64_t medias[64];
+    for (uint i = 0; i < 64; ++i) {
+        medias[i] = (uint64_t)(i + 1) * (i + 1) * 9973u;
+        tensoes[i] = (i + 1) * 0.0137f;
+    }
+
+    volatile float db = 0.f;
+    volatile int32_t mdb = 0;
+    uint32_t status = save_and_disable_interrupts();
+
+    uint32_t inicio = ciclos_agora();
+    for (uint i = 0; i < 64; ++i)
+        db = bench_db_log10f(tensoes[i]);
+    uint32_t ciclos_log10f = ciclos_desde(inicio);
+
+    inicio = ciclos_agora();
+    for (uint i = 0; i < 64; ++i)
+        db = calculate_db(tensoes[i]);
+    uint32_t ciclos_float = ciclos_desde(inicio);
+
+    inicio = ciclos_agora();
+    for (uint i = 0; i < 64; ++i)
+        mdb = potencia_para_mdb(medias[i]);
+    uint32_t ciclos_inteiro = ciclos_desde(inicio);
+
+    restore_interrupts(status);
+    (void)db;
+    (void)mdb;
+
+    printf("[BENCH] %-28s %lu ciclos/conversao\n", "log10f", (unsigned long)(ciclos_log10f / 64));
+    printf("[BENCH] %-28s %lu ciclos/conversao\n", "calculate_db (bits do float)", (unsigned long)(ciclos_float / 64));
+    printf("[BENCH] %-28s %lu ciclos/conversao\n", "potencia_para_mdb (inteiro)", (unsigned long)(ciclos_inteiro / 64));
+
+    // Toda amplitude do ADC no formato interno, ao quadrado (média de um tom constante)
+    double erro_max = 0.0;
+    for (uint32_t a = 1; a <= (ADC_BIAS_CODE << AUDIO_FRAC_BITS); ++a) {
+        uint64_t media = (uint64_t)a * a;
+        double erro = fabs(potencia_para_mdb(media) / 1000.0 - 10.0 * log10((double)media));
+        if (erro > erro_max)
+            erro_max = erro;
+    }
+    printf("[BENCH] Erro maximo de potencia_para_mdb na faixa do ADC: %.4f dB\n", erro_max);
+}
+
+/**
+ * Codificação IMA-ADPCM de um bloco decimado: ciclos por amostra para
+ * codificar e decodificar, amostras por segundo que um núcleo sustenta e a
+ * relação sinal/ruído da reconstrução, para um tom forte e um fraco.
+ */
+static void benchmark_adpcm() {
+    static int16_t entrada[SAMPLES], saida[SAMPLES];
+    static uint8_t codigo[ADPCM_BYTES_BLOCO(SAMPLES)];
+    static const float amplitudes[2] = {16384.f, 328.f};  // -6 dB e -40 dB do fundo de escala
+    const uint32_t clock = clock_get_hz(clk_sys);
+
+    for (uint a = 0; a < 2; ++a) {
+        uint32_t semente = 12345;
+        for (uint i = 0; i < SAMPLES; ++i) {
+            semente = semente * 1664525u + 1013904223u;  // LCG
+            int32_t ruido = (int32_t)(semente >> 26) - 32;
+            entrada[i] = (int16_t)(amplitudes[a] * sinf(2.f * (float)M_PI * 1000.f * i / AUDIO_SAMPLE_RATE) + ruido);
+        }
+
+        // O passo converge nos primeiros blocos; a medição usa o estado já adaptado
+        adpcm_estado_t estado;
+        adpcm_iniciar(&estado);
+        for (uint r = 0; r < 4; ++r)
+            adpcm_codificar_bloco(&estado, entrada, SAMPLES, codigo);
+
+        uint32_t status = save_and_disable_interrupts();
+        uint32_t inicio = ciclos_agora();
+        for (uint r = 0; r < BENCH_REPETICOES; ++r)
+            adpcm_codificar_bloco(&estado, entrada, SAMPLES, codigo);
+        uint32_t ciclos_codificar = ciclos_desde(inicio);
+
+        inicio = ciclos_agora();
+        for (uint r = 0; r < BENCH_REPETICOES; ++r)
+            adpcm_decodificar_bloco(codigo, SAMPLES, saida);
+        uint32_t ciclos_decodificar = ciclos_desde(inicio);
+        restore_interrupts(status);
+
+        double sinal = 0.0, erro = 0.0;
+        for (uint i = 0; i < SAMPLES; ++i) {
+            double d = (double)entrada[i] - saida[i];
+            sinal += (double)entrada[i] * entrada[i];
+            erro += d * d;
+        }
+
+        const uint32_t amostras = BENCH_REPETICOES * SAMPLES;
+        printf("[BENCH] ADPCM %+.0f dBFS: SNR %.1f dB\n", 20.f * log10f(amplitudes[a] / 32768.f),
+               10.0 * log10(sinal / (erro > 0.0 ? erro : 1.0)));
+        bench_imprime("adpcm_codificar_bloco", ciclos_codificar, amostras);
+        bench_imprime("adpcm_decodificar_bloco", ciclos_decodificar, amostras);
+        printf("[BENCH] ADPCM por nucleo: %lu amostras/s codificando (%.2f%% do nucleo a %u Hz)\n",
+               (unsigned long)((uint64_t)clock * amostras / ciclos_codificar),
+               100.f * ciclos_codificar / amostras * AUDIO_SAMPLE_RATE / clock, AUDIO_SAMPLE_RATE);
+    }
+}
+
+/**
+ * Custo no ponto de registro: REGISTRO() com quatro argumentos contra o
+ * snprintf do mesmo texto (só a formatação, sem a USB). Os registros de
+ * teste são enviados em seguida, como linhas [R].
+ */
+static void benchmark_registro() {
+    static char texto[96];
+    const float nivel = 63.25f;
+
+    uint32_t status = save_and_disable_interrupts();
+    uint32_t inicio = ciclos_agora();
+    for (uint r = 0; r < BENCH_REPETICOES; ++r)
+        REGISTRO(REG_BENCH, r, registro_f(nivel), -(int32_t)r, registro_s("teste"));
+    uint32_t ciclos_registro = ciclos_desde(inicio);
+
+    inicio = ciclos_agora();
+    for (uint r = 0; r < BENCH_REPETICOES; ++r)
+        snprintf(texto, sizeof(texto), "[BENCH] Registro de teste %u: %.2f dB, %d, %s", r, nivel, -(int)r, "teste");
+    uint32_t ciclos_snprintf = ciclos_desde(inicio);
+    restore_interrupts(status);
+
+    printf("[BENCH] %-28s %lu ciclos/chamada\n", "REGISTRO (4 argumentos)",
+           (unsigned long)(ciclos_registro / BENCH_REPETICOES));
+    printf("[BENCH] %-28s %lu ciclos/chamada\n", "snprintf do mesmo texto",
+           (unsigned long)(ciclos_snprintf / BENCH_REPETICOES));
+    registro_drenar(BENCH_REPETICOES);
+}
+
+/**
+ * Desenha os textos da tela normal (dois títulos em escala 2 e duas linhas
+ * em escala 1) com a função dada.
+ */
+static void bench_tela_texto(void (*desenhar)(ssd1306_t *, uint32_t, uint32_t, uint32_t, const char *)) {
+    ssd1306_clear(&disp);
+    desenhar(&disp, 1, 5, 2, "SOUND");
+    desenhar(&disp, 20, 20, 2, "MONITOR");
+    desenhar(&disp, 5, 40, 1, "Volume: Moderado");
+    desenhar(&disp, 5, 50, 1, "LAF: 61.23 dB");
+}
+
+/**
+ * Texto da tela normal por quadro: desenho por pixel do driver contra o
+ * texto_desenhar() nos bytes das páginas, conferindo que o quadro é igual.
+ */
+static void benchmark_texto() {
+    static uint8_t referencia[DISPLAY_LARGURA * DISPLAY_PAGINAS];
+    bench_tela_texto(texto_desenhar);  // Monta o cache da escala 2 fora da medição
+
+    uint32_t status = save_and_disable_interrupts();
+    uint32_t inicio = ciclos_agora();
+    for (uint r = 0; r < BENCH_REPETICOES; ++r)
+        bench_tela_texto(ssd1306_draw_string);
+    uint32_t ciclos_pixel = ciclos_desde(inicio);
+    memcpy(referencia, disp.buffer, sizeof(referencia));
+
+    inicio = ciclos_agora();
+    for (uint r = 0; r < BENCH_REPETICOES; ++r)
+        bench_tela_texto(texto_desenhar);
+    uint32_t ciclos_bytes = ciclos_desde(inicio);
+    restore_interrupts(status);
+
+    printf("[BENCH] %-28s %lu ciclos/quadro\n", "texto por pixel (driver)",
+           (unsigned long)(ciclos_pixel / BENCH_REPETICOES));
+    printf("[BENCH] %-28s %lu ciclos/quadro (%s)\n", "texto nos bytes das paginas",
+           (unsigned long)(ciclos_bytes / BENCH_REPETICOES),
+           memcmp(referencia, disp.buffer, sizeof(referencia)) == 0 ? "quadro igual" : "QUADRO DIFERENTE");
+    ssd1306_clear(&disp);
+}
+
+/**
+ * Envio de quadros ao display (us, não ciclos): ssd1306_show() bloqueante
+ * contra display_atualizar() por DMA, com o quadro inteiro e com um texto
+ * alterado; para o DMA, o tempo de CPU até o retorno e o tempo até o fim do
+ * envio no barramento.
+ */
+static void benchmark_display() {
+    limpar_tela();
+    print_texto("SOUND", 1, 1, 2);
+    print_texto("MONITOR", 20, 17, 2);
+
+    display_esperar();
+    uint64_t inicio = time_us_64();
+    ssd1306_show(&disp);
+    uint32_t bloqueante = (uint32_t)(time_us_64() - inicio);
+
+    display_invalidar();
+    inicio = time_us_64();
+    display_atualizar();
+    uint32_t cpu_inteiro = (uint32_t)(time_us_64() - inicio);
+    display_esperar();
+    uint32_t total_inteiro = (uint32_t)(time_us_64() - inicio);
+
+    print_texto("88.8 dB", 20, 40, 1);
+    inicio = time_us_64();
+    display_atualizar();
+    uint32_t cpu_parcial = (uint32_t)(time_us_64() - inicio);
+    display_esperar();
+    uint32_t total_parcial = (uint32_t)(time_us_64() - inicio);
+    display_stats_t d;
+    display_get_stats(&d);
+
+    printf("[BENCH] %-28s %lu us (%u bytes)\n", "ssd1306_show bloqueante", (unsigned long)bloqueante,
+           (unsigned)DISPLAY_BYTES_QUADRO_INTEIRO);
+    printf("[BENCH] %-28s %lu us de CPU, %lu us ate o fim\n", "quadro inteiro por DMA",
+           (unsigned long)cpu_inteiro, (unsigned long)total_inteiro);
+    printf("[BENCH] %-28s %lu us de CPU, %lu us ate o fim (%u bytes)\n", "texto alterado por DMA",
+           (unsigned long)cpu_parcial, (unsigned long)total_parcial, (unsigned)d.bytes_ultimo);
+}
+
+/**
+ * Executa todos os benchmarks e imprime os resultados no console.
+ */
+void benchmark_executar() {
+    ciclos_iniciar();
+    printf("\n[BENCH] Benchmarks de desempenho (clock do processador)\n");
+    benchmark_rms();
+    benchmark_picos();
+    benchmark_correcoes();
+    benchmark_ponderacao();
+    benchmark_espectro();
+    benchmark_decibel();
+    benchmark_adpcm();
+    benchmark_registro();
+    benchmark_texto();
+    benchmark_display();
+}
@@ -0,0 +1,209 @@
+#include "lib/botoes.h"     // Botões por interrupção com debounce e gestos
+#include "lib/fila_spsc.h"  // Fila das interrupções até as tarefas
+#include "lib/agendador.h"  // Libera a tarefa dos botões a cada gesto
+#include <stdio.h>
+
+// Estado de cada botão (alterado só nas interrupções do núcleo 0)
+typedef struct {
+    uint pino;
+    uint32_t longo_us;          // Tempo pressionado para o toque longo
+    bool pressionado;           // Último nível confirmado pelo debounce
+    bool debounce;              // Alarme de debounce pendente (interrupção do GPIO desligada)
+    bool longo_emitido;         // O toque atual já virou longo
+    bool duplo_emitido;         // O toque atual já virou duplo
+    uint64_t borda_us;          // Primeira borda ainda não confirmada
+    uint64_t inicio_us;         // Início do toque atual
+    uint64_t curto_us;          // Fim do último toque curto (0: nenhum esperando o duplo)
+    alarm_id_t alarme_longo;
+    alarm_id_t alarme_curto;    // Fim da janela do duplo: o toque curto só sai se não vier outro
+} botao_t;
+
+static botao_t botoes[BOTOES_MAX];
+static uint num_botoes = 0;
+static int tarefa_aviso = -1;
+
+static fila_spsc_t fila_eventos;
+static botao_evento_t fila_armazenamento[BOTOES_FILA_CAPACIDADE];
+static botoes_stats_t stats;
+
+/**
+ * Coloca um gesto na fila e libera a tarefa dos botões.
+ */
+static void emitir(uint botao, botao_gesto_t gesto, uint64_t referencia_us) {
+    botao_evento_t evento = {
+        .botao = (uint8_t)botao,
+        .gesto = (uint8_t)gesto,
+        .inicio_us = botoes[botao].inicio_us,
+        .referencia_us = referencia_us,
+        .emitido_us = time_us_64(),
+    };
+    uint32_t deteccao = (uint32_t)(evento.emitido_us - referencia_us);
+    if (deteccao > stats.deteccao_max_us)
+        stats.deteccao_max_us = deteccao;
+    fila_spsc_push(&fila_eventos, &evento);
+    agendador_liberar(tarefa_aviso);
+}
+
+/**
+ * Alarme do toque longo: o botão continua pressionado.
+ */
+static int64_t alarme_longo(alarm_id_t id, void *dados) {
+    botao_t *b = dados;
+    b->alarme_longo = 0;
+    if (b->pressionado && !b->duplo_emitido) {
+        b->longo_emitido = true;
+        emitir(b - botoes, BOTAO_LONGO, b->inicio_us + b->longo_us);
+    }
+    return 0;
+}
+
+/**
+ * Alarme do fim da janela do duplo: nenhum segundo toque veio, então o toque
+ * anterior sai como curto. Com uma borda ainda no debounce, espera por ela
+ * (o debounce decide entre duplo e curto).
+ */
+static int64_t alarme_curto(alarm_id_t id, void *dados) {
+    botao_t *b = dados;
+    if (b->debounce)
+        return BOTOES_DEBOUNCE_US;
+    b->alarme_curto = 0;
+    emitir(b - botoes, BOTAO_CURTO, b->curto_us + BOTOES_DUPLO_MS * 1000ull);
+    b->curto_us = 0;
+    return 0;
+}
+
+/**
+ * Alarme do debounce: confirma o nível depois de BOTOES_DEBOUNCE_US, avança
+ * a máquina de estados e volta a ouvir as bordas. As bordas do intervalo
+ * são descartadas antes da leitura; uma mudança depois dela gera nova borda.
+ */
+static int64_t alarme_debounce(alarm_id_t id, void *dados) {
+    botao_t *b = dados;
+    uint botao = b - botoes;
+    gpio_acknowledge_irq(b->pino, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE);
+    bool pressionado = !gpio_get(b->pino);
+    b->debounce = false;
+    gpio_set_irq_enabled(b->pino, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+
+    if (pressionado == b->pressionado)
+        return 0;  // Só ruído: o nível voltou ao que era
+    b->pressionado = pressionado;
+
+    if (pressionado) {
+        bool duplo = b->curto_us != 0 && b->borda_us - b->curto_us <= BOTOES_DUPLO_MS * 1000ull;
+        if (b->alarme_curto > 0) {
+            cancel_alarm(b->alarme_curto);
+            b->alarme_curto = 0;
+            if (!duplo)  // A janela acabou durante o debounce: o toque anterior foi curto
+                emitir(botao, BOTAO_CURTO, b->curto_us + BOTOES_DUPLO_MS * 1000ull);
+        }
+        b->inicio_us = b->borda_us;
+        b->longo_emitido = false;
+        b->duplo_emitido = duplo;
+        b->curto_us = 0;
+        emitir(botao, BOTAO_PRESSIONADO, b->borda_us);
+        if (b->duplo_emitido)
+            emitir(botao, BOTAO_DUPLO, b->borda_us);
+        else
+            b->alarme_longo = add_alarm_at(from_us_since_boot(b->inicio_us + b->longo_us), alarme_longo, b, true);
+    } else {
+        if (b->alarme_longo > 0)
+            cancel_alarm(b->alarme_longo);
+        b->alarme_longo = 0;
+        if (!b->longo_emitido && !b->duplo_emitido) {
+            b->curto_us = b->borda_us;
+            b->alarme_curto = add_alarm_at(from_us_since_boot(b->curto_us + BOTOES_DUPLO_MS * 1000ull),
+                                           alarme_curto, b, true);
+            if (b->alarme_curto <= 0)
+                alarme_curto(0, b);  // Sem alarme livre: sai já como curto
+        }
+    }
+    return 0;
+}
+
+/**
+ * Interrupção das bordas: guarda o instante e espera o nível estabilizar.
+ */
+static void botoes_gpio_irq(uint pino, uint32_t eventos) {
+    for (uint i = 0; i < num_botoes; ++i) {
+        botao_t *b = &botoes[i];
+        if (b->pino != pino || b->debounce)
+            continue;
+        b->borda_us = time_us_64();
+        b->debounce = true;
+        gpio_set_irq_enabled(pino, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, false);
+        if (add_alarm_in_us(BOTOES_DEBOUNCE_US, alarme_debounce, b, true) <= 0)
+            alarme_debounce(0, b);  // Sem alarme livre: confirma já, sem debounce
+    }
+}
+
+/**
+ * Configura o pino (entrada com pull-up) e liga as interrupções das duas
+ * bordas. Deve ser chamada no núcleo 0. Retorna o índice do botão ou -1.
+ */
+int botoes_adicionar(uint pino, uint32_t longo_ms) {
+    if (num_botoes >= BOTOES_MAX)
+        return -1;
+    if (num_botoes == 0)
+        fila_spsc_init(&fila_eventos, fila_armazenamento, sizeof(botao_evento_t), BOTOES_FILA_CAPACIDADE);
+
+    gpio_init(pino);
+    gpio_set_dir(pino, GPIO_IN);
+    gpio_pull_up(pino);
+    botoes[num_botoes] = (botao_t){
+        .pino = pino,
+        .longo_us = longo_ms * 1000,
+        .pressionado = !gpio_get(pino),
+    };
+    gpio_set_irq_enabled_with_callback(pino, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, botoes_gpio_irq);
+    return (int)num_botoes++;
+}
+
+/**
+ * Tarefa do agendador liberada a cada gesto.
+ */
+void botoes_set_tarefa(int tarefa) {
+    tarefa_aviso = tarefa;
+}
+
+/**
+ * Retorna o último nível confirmado do botão.
+ */
+bool botoes_pressionado(int botao) {
+    return botao >= 0 && (uint)botao < num_botoes && botoes[botao].pressionado;
+}
+
+/**
+ * Retira o próximo gesto da fila (núcleo 0, fora das interrupções).
+ */
+bool botoes_obter_evento(botao_evento_t *evento) {
+    if (num_botoes == 0 || !fila_spsc_pop(&fila_eventos, evento))
+        return false;
+    uint32_t tratamento = (uint32_t)(time_us_64() - evento->referencia_us);
+    stats.eventos++;
+    stats.tratamento_us += tratamento;
+    if (tratamento > stats.tratamento_max_us)
+        stats.tratamento_max_us = tratamento;
+    return true;
+}
+
+/**
+ * Copia os contadores de latência.
+ */
+void botoes_get_stats(botoes_stats_t *saida) {
+    *saida = stats;
+    saida->descartados = fila_eventos.descartados;
+}
+
+/**
+ * Imprime as latências dos gestos desde o boot.
+ */
+void botoes_relatorio() {
+    botoes_stats_t s;
+    botoes_get_stats(&s);
+    if (s.eventos == 0)
+        return;
+    printf("[BOTOES] %u gestos, %u descartados, deteccao max %u us, tratamento medio %u us, max %u us\n",
+           (unsigned)s.eventos, (unsigned)s.descartados, (unsigned)s.deteccao_max_us,
+           (unsigned)(s.tratamento_us / s.eventos), (unsigned)s.tratamento_max_us);
+}
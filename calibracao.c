@@ -0,0 +1,135 @@
+#include "lib/calibracao.h"    // Calibração de campo do microfone
+#include "lib/config_flash.h"  // Valores gravados na flash
+#include "lib/microfone.h"     // Calibração e limiares em uso
+#include "lib/nucleo_dsp.h"    // Medições do núcleo 1
+#include "lib/display_oled.h"  // Mensagens da calibração
+#include <math.h>
+#include <stdio.h>
+
+#define CALIBRACAO_TIMEOUT_MS 3000  // Espera máxima por uma medição
+
+/**
+ * Aplica a calibração, os limiares e o perfil de DNL gravados na flash (ou
+ * mantém os padrões). Chamada antes de nucleo_dsp_iniciar().
+ */
+void calibracao_carregar() {
+    mic_calibracao_t calibracao;
+    if (config_ler(CONFIG_CALIBRACAO, &calibracao, sizeof(calibracao))) {
+        mic_set_calibracao(&calibracao);
+        printf("[INFO] Calibracao da flash: ganho %+.2f dB, bias %.2f\n",
+               calibracao.ganho_mdb / 1000.f, calibracao.bias / (float)(1 << AUDIO_FRAC_BITS));
+    }
+
+    int16_t limiares[MIC_LIMIARES];
+    if (config_ler(CONFIG_LIMIARES, limiares, sizeof(limiares)))
+        mic_set_limiares(limiares);
+
+    // Perfil de DNL medido nesta placa (senão fica o típico do RP2040)
+    int16_t dnl[ADC_DNL_PONTOS];
+    if (config_ler(CONFIG_ADC_DNL, dnl, sizeof(dnl)))
+        mic_set_dnl(dnl);
+}
+
+// Calibração em andamento: avança a cada medição entregue por calibracao_processar()
+static struct {
+    calibracao_estado_t estado;
+    float nivel_db;
+    bool descartar;             // A primeira medição já estava em andamento no início
+    uint medicoes;
+    double energia;             // Soma das potências relativas (10^(dB/10))
+    int64_t dc;
+    absolute_time_t limite;     // Prazo da próxima medição
+} cal = {.estado = CALIBRACAO_INATIVA};
+
+/**
+ * Inicia a calibração de campo: com o calibrador acoplado ao microfone e a
+ * captura ligada, mede o nível equivalente por CALIBRACAO_MEDICOES segundos
+ * e corrige o ganho para que ele leia nivel_db; o nível DC que sobrar vira o
+ * novo bias. Não bloqueia: as medições chegam por calibracao_processar().
+ */
+void calibracao_iniciar(float nivel_db) {
+    printf("[CALIBRACAO] Aplique o calibrador de %.1f dB ao microfone...\n", nivel_db);
+    exibir_tela_calibracao(nivel_db, "Medindo...");
+    cal.estado = CALIBRACAO_MEDINDO;
+    cal.nivel_db = nivel_db;
+    cal.descartar = true;
+    cal.medicoes = 0;
+    cal.energia = 0.0;
+    cal.dc = 0;
+    cal.limite = make_timeout_time_ms(CALIBRACAO_TIMEOUT_MS);
+}
+
+/**
+ * Interrompe a calibração em andamento sem aplicar nada.
+ */
+void calibracao_cancelar() {
+    cal.estado = CALIBRACAO_INATIVA;
+}
+
+/**
+ * Retorna true entre calibracao_iniciar() e o resultado.
+ */
+bool calibracao_ativa() {
+    return cal.estado == CALIBRACAO_MEDINDO;
+}
+
+/**
+ * Termina a calibração: aplica a correção, grava na flash e mostra o resultado.
+ */
+static calibracao_estado_t calibracao_concluir(bool ok) {
+    mic_calibracao_t calibracao;
+    mic_get_calibracao(&calibracao);
+    float medido = (float)(10.0 * log10(cal.energia / CALIBRACAO_MEDICOES));
+    float correcao = cal.nivel_db - medido;
+    if (ok && fabsf(correcao) > CALIBRACAO_CORRECAO_MAX) {
+        printf("[CALIBRACAO] Nivel medido %.1f dB: calibrador ausente?\n", medido);
+        ok = false;
+    }
+    cal.estado = CALIBRACAO_INATIVA;
+    if (!ok) {
+        exibir_tela_calibracao(cal.nivel_db, "Falhou");
+        return CALIBRACAO_FALHOU;
+    }
+
+    calibracao.ganho_mdb += (int32_t)lroundf(correcao * 1000.f);
+    calibracao.bias += (int32_t)(cal.dc / CALIBRACAO_MEDICOES);
+    mic_set_calibracao(&calibracao);
+    bool gravado = config_gravar(CONFIG_CALIBRACAO, &calibracao, sizeof(calibracao));
+
+    printf("[CALIBRACAO] Medido %.2f dB, correcao %+.2f dB: ganho %+.3f dB, bias %.2f%s\n",
+           medido, correcao, calibracao.ganho_mdb / 1000.f,
+           calibracao.bias / (float)(1 << AUDIO_FRAC_BITS), gravado ? "" : " (falha ao gravar na flash)");
+    exibir_tela_calibracao(cal.nivel_db, gravado ? "Concluida" : "Erro na flash");
+    return gravado ? CALIBRACAO_CONCLUIDA : CALIBRACAO_FALHOU;
+}
+
+/**
+ * Avança a calibração com uma nova medição do núcleo 1 (ou NULL, só para
+ * conferir o prazo). Retorna CALIBRACAO_CONCLUIDA ou CALIBRACAO_FALHOU uma
+ * única vez, no fim; depois a calibração fica inativa.
+ */
+calibracao_estado_t calibracao_processar(const medicao_t *medicao) {
+    if (cal.estado != CALIBRACAO_MEDINDO)
+        return cal.estado;
+    if (medicao == NULL) {
+        if (!time_reached(cal.limite))
+            return CALIBRACAO_MEDINDO;
+        printf("[CALIBRACAO] Sem medicoes do nucleo 1\n");
+        return calibracao_concluir(false);
+    }
+
+    cal.limite = make_timeout_time_ms(CALIBRACAO_TIMEOUT_MS);
+    if (cal.descartar) {
+        cal.descartar = false;
+        return CALIBRACAO_MEDINDO;
+    }
+    if (medicao->saturadas_min || medicao->saturadas_max) {
+        printf("[CALIBRACAO] ADC saturado: reduza o ganho do microfone\n");
+        return calibracao_concluir(false);
+    }
+    cal.energia += pow(10.0, medicao->db / 10.0);
+    cal.dc += medicao->dc;
+    if (++cal.medicoes < CALIBRACAO_MEDICOES)
+        return CALIBRACAO_MEDINDO;
+    return calibracao_concluir(true);
+}
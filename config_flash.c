@@ -0,0 +1,294 @@
+#include "lib/config_flash.h"  // Armazenamento chave/valor na flash
+#include "pico/flash.h"         // flash_safe_execute: pausa o outro núcleo durante a gravação
+#include "lib/nucleo_dsp.h"     // Para a captura do núcleo 1 antes de gravar
+#include <string.h>
+
+#define CONFIG_MAGICA 0x47464353u  // "SCFG": cabeçalho de setor válido
+#define CONFIG_CABECALHO 8         // Mágica + geração
+#define CONFIG_TIMEOUT_MS 100      // Espera máxima pelo outro núcleo antes de desistir da gravação
+
+// Tamanho de um registro na flash: cabeçalho de 4 bytes + valor alinhado em 4
+#define CONFIG_REGISTRO(tamanho) (4 + (((tamanho) + 3u) & ~3u))
+
+// Imagem de um setor compactado (todas as chaves no tamanho máximo), em
+// páginas inteiras; também serve para acrescentar um registro que cruza páginas
+#define CONFIG_IMAGEM ((CONFIG_CABECALHO + (CONFIG_CHAVES - 1) * CONFIG_REGISTRO(CONFIG_VALOR_MAX) + \
+                        FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE)
+
+// Cópia em RAM do valor atual de cada chave: leituras nunca tocam a flash
+typedef struct {
+    bool presente;
+    uint8_t tamanho;
+    uint8_t valor[CONFIG_VALOR_MAX];
+} config_entrada_t;
+
+static config_entrada_t cache[CONFIG_CHAVES];
+static config_stats_t estado;
+static uint32_t posicao;  // Próximo byte livre no setor ativo
+
+// Páginas montadas em RAM antes de gravar (bytes em 0xFF não alteram a flash)
+static uint8_t buffer_flash[MAX(CONFIG_IMAGEM, 2 * FLASH_PAGE_SIZE)];
+
+// Operação executada com o outro núcleo pausado
+typedef struct {
+    uint32_t offset;             // Offset na flash (a partir do início da flash)
+    uint32_t tamanho;            // Bytes de buffer_flash a gravar (múltiplo de FLASH_PAGE_SIZE)
+    bool apagar;                 // Apaga o setor antes e grava o cabeçalho por último
+} config_operacao_t;
+
+/**
+ * Endereço de leitura (XIP) de um setor da área de configuração.
+ */
+static const uint8_t *setor_endereco(uint32_t setor) {
+    return (const uint8_t *)(XIP_BASE + CONFIG_FLASH_OFFSET + setor * FLASH_SECTOR_SIZE);
+}
+
+/**
+ * Fletcher-16 sobre a chave, o tamanho e o valor de um registro.
+ */
+static uint16_t verificacao(uint8_t chave, uint8_t tamanho, const uint8_t *valor) {
+    uint32_t a = chave, b = chave;
+    a = (a + tamanho) % 255;
+    b = (b + a) % 255;
+    for (uint i = 0; i < tamanho; ++i) {
+        a = (a + valor[i]) % 255;
+        b = (b + a) % 255;
+    }
+    return (uint16_t)((b << 8) | a);
+}
+
+/**
+ * Grava no setor ativo ou no próximo. Roda com o outro núcleo pausado e as
+ * interrupções deste núcleo desligadas; o código que as funções da flash
+ * executam já está em RAM.
+ */
+static void config_executar(void *param) {
+    const config_operacao_t *op = (const config_operacao_t *)param;
+    if (!op->apagar) {
+        flash_range_program(op->offset, buffer_flash, op->tamanho);
+        return;
+    }
+
+    // Setor novo: os registros primeiro e o cabeçalho por último, para que
+    // uma queda de energia no meio deixe o setor antigo como o válido
+    uint8_t cabecalho[CONFIG_CABECALHO];
+    memcpy(cabecalho, buffer_flash, CONFIG_CABECALHO);
+    memset(buffer_flash, 0xFF, CONFIG_CABECALHO);
+
+    flash_range_erase(op->offset, FLASH_SECTOR_SIZE);
+    flash_range_program(op->offset, buffer_flash, op->tamanho);
+
+    memset(buffer_flash, 0xFF, FLASH_PAGE_SIZE);
+    memcpy(buffer_flash, cabecalho, CONFIG_CABECALHO);
+    flash_range_program(op->offset, buffer_flash, FLASH_PAGE_SIZE);
+}
+
+/**
+ * Executa a operação com a captura parada: o núcleo 1 fica pausado durante
+ * a gravação (até ~50 ms num apagamento) e o DMA do ADC, sem a interrupção
+ * dele para voltar ao início do buffer, escreveria além de adc_buffer.
+ */
+static bool config_executar_seguro(config_operacao_t *op) {
+    bool ok = nucleo_dsp_suspender(true) &&
+              flash_safe_execute(config_executar, op, CONFIG_TIMEOUT_MS) == PICO_OK;
+    nucleo_dsp_suspender(false);
+    return ok;
+}
+
+/**
+ * Monta um registro em destino e retorna quantos bytes ele ocupa.
+ */
+static uint32_t registro_montar(uint8_t *destino, uint8_t chave, const uint8_t *valor, uint8_t tamanho) {
+    uint16_t soma = verificacao(chave, tamanho, valor);
+    destino[0] = chave;
+    destino[1] = tamanho;
+    destino[2] = (uint8_t)soma;
+    destino[3] = (uint8_t)(soma >> 8);
+    memcpy(&destino[4], valor, tamanho);
+    return CONFIG_REGISTRO(tamanho);
+}
+
+/**
+ * Lê os registros de um setor para o cache; o último valor de cada chave
+ * vence. Retorna o offset do primeiro byte livre, ou FLASH_SECTOR_SIZE se
+ * o fim do log estiver ilegível (a próxima gravação compacta).
+ */
+static uint32_t setor_carregar(uint32_t setor) {
+    const uint8_t *base = setor_endereco(setor);
+    uint32_t pos = CONFIG_CABECALHO;
+
+    while (pos + 4 <= FLASH_SECTOR_SIZE) {
+        uint8_t chave = base[pos], tamanho = base[pos + 1];
+        uint16_t soma = base[pos + 2] | (base[pos + 3] << 8);
+
+        if (chave == 0xFF && tamanho == 0xFF && soma == 0xFFFF)
+            return pos;  // Fim do log: flash apagada
+        if (chave == 0 || chave >= CONFIG_CHAVES || tamanho > CONFIG_VALOR_MAX ||
+            pos + CONFIG_REGISTRO(tamanho) > FLASH_SECTOR_SIZE) {
+            estado.registros_invalidos++;
+            return FLASH_SECTOR_SIZE;
+        }
+
+        if (soma == verificacao(chave, tamanho, &base[pos + 4])) {
+            cache[chave].presente = true;
+            cache[chave].tamanho = tamanho;
+            memcpy(cache[chave].valor, &base[pos + 4], tamanho);
+        } else {
+            estado.registros_invalidos++;  // Gravação interrompida: o valor anterior continua valendo
+        }
+        pos += CONFIG_REGISTRO(tamanho);
+    }
+    return FLASH_SECTOR_SIZE;
+}
+
+/**
+ * Encontra o setor mais recente e carrega os valores para a RAM.
+ * Deve ser chamada antes de qualquer leitura ou gravação.
+ */
+void config_init() {
+    memset(cache, 0, sizeof(cache));
+    memset(&estado, 0, sizeof(estado));
+
+    bool encontrado = false;
+    for (uint32_t s = 0; s < CONFIG_SETORES; ++s) {
+        const uint32_t *cabecalho = (const uint32_t *)setor_endereco(s);
+        if (cabecalho[0] != CONFIG_MAGICA)
+            continue;
+        if (!encontrado || cabecalho[1] > estado.geracao) {
+            estado.setor = s;
+            estado.geracao = cabecalho[1];
+            encontrado = true;
+        }
+    }
+
+    if (!encontrado) {
+        // Área nunca usada: a primeira gravação formata o setor 0
+        estado.setor = CONFIG_SETORES - 1;
+        posicao = FLASH_SECTOR_SIZE;
+    } else {
+        posicao = setor_carregar(estado.setor);
+    }
+    estado.livre = FLASH_SECTOR_SIZE - posicao;
+}
+
+/**
+ * Copia os valores atuais para o próximo setor do rodízio, junto com o
+ * cache já atualizado, e passa a usá-lo.
+ */
+static bool config_compactar() {
+    const uint32_t proximo = (estado.setor + 1) % CONFIG_SETORES;
+
+    memset(buffer_flash, 0xFF, sizeof(buffer_flash));
+    const uint32_t cabecalho[2] = {CONFIG_MAGICA, estado.geracao + 1};
+    memcpy(buffer_flash, cabecalho, sizeof(cabecalho));
+
+    uint32_t pos = CONFIG_CABECALHO;
+    for (uint c = 1; c < CONFIG_CHAVES; ++c) {
+        if (cache[c].presente)
+            pos += registro_montar(&buffer_flash[pos], c, cache[c].valor, cache[c].tamanho);
+    }
+
+    config_operacao_t op = {
+        .offset = CONFIG_FLASH_OFFSET + proximo * FLASH_SECTOR_SIZE,
+        .tamanho = (pos + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE,
+        .apagar = true,
+    };
+    if (!config_executar_seguro(&op))
+        return false;
+
+    estado.setor = proximo;
+    estado.geracao++;
+    posicao = pos;
+    estado.livre = FLASH_SECTOR_SIZE - posicao;
+    return true;
+}
+
+/**
+ * Grava o valor de uma chave. Valores iguais ao atual não são regravados.
+ * Só o núcleo 0 grava; a captura para durante a gravação (o núcleo 1 fica
+ * pausado em RAM por até ~50 ms quando um setor é apagado) e a medição em
+ * andamento perde esse trecho de áudio.
+ */
+bool config_gravar(config_chave_t chave, const void *valor, uint tamanho) {
+    if (chave == 0 || chave >= CONFIG_CHAVES || tamanho > CONFIG_VALOR_MAX)
+        return false;
+
+    config_entrada_t *entrada = &cache[chave];
+    if (entrada->presente && entrada->tamanho == tamanho && memcmp(entrada->valor, valor, tamanho) == 0)
+        return true;
+
+    const uint32_t bytes = CONFIG_REGISTRO(tamanho);
+    if (posicao + bytes > FLASH_SECTOR_SIZE) {
+        // Setor cheio: o novo valor vai junto na compactação
+        config_entrada_t anterior = *entrada;
+        entrada->presente = true;
+        entrada->tamanho = tamanho;
+        memcpy(entrada->valor, valor, tamanho);
+        if (!config_compactar()) {
+            *entrada = anterior;
+            return false;
+        }
+        return true;
+    }
+
+    // Acrescenta o registro às páginas que ele ocupa
+    const uint32_t primeira = posicao & ~(FLASH_PAGE_SIZE - 1);
+    const uint32_t fim = (posicao + bytes + FLASH_PAGE_SIZE - 1) & ~(FLASH_PAGE_SIZE - 1);
+    memset(buffer_flash, 0xFF, fim - primeira);
+    registro_montar(&buffer_flash[posicao - primeira], chave, valor, tamanho);
+
+    config_operacao_t op = {
+        .offset = CONFIG_FLASH_OFFSET + estado.setor * FLASH_SECTOR_SIZE + primeira,
+        .tamanho = fim - primeira,
+        .apagar = false,
+    };
+    if (!config_executar_seguro(&op))
+        return false;
+
+    entrada->presente = true;
+    entrada->tamanho = tamanho;
+    memcpy(entrada->valor, valor, tamanho);
+    posicao += bytes;
+    estado.livre = FLASH_SECTOR_SIZE - posicao;
+    return true;
+}
+
+/**
+ * Copia o valor atual de uma chave (da RAM). Retorna false, sem alterar
+ * valor, se a chave nunca foi gravada ou foi gravada com outro tamanho.
+ */
+bool config_ler(config_chave_t chave, void *valor, uint tamanho) {
+    if (chave == 0 || chave >= CONFIG_CHAVES)
+        return false;
+    const config_entrada_t *entrada = &cache[chave];
+    if (!entrada->presente || entrada->tamanho != tamanho)
+        return false;
+    memcpy(valor, entrada->valor, tamanho);
+    return true;
+}
+
+/**
+ * Copia um texto gravado (ou o padrão, se não houver) para texto, sempre
+ * terminado em '\0'. Retorna true se o valor veio do armazenamento.
+ */
+bool config_ler_texto(config_chave_t chave, char *texto, uint tamanho, const char *padrao) {
+    const config_entrada_t *entrada = chave > 0 && chave < CONFIG_CHAVES ? &cache[chave] : NULL;
+    bool gravado = entrada != NULL && entrada->presente && entrada->tamanho > 0;
+    const char *origem = gravado ? (const char *)entrada->valor : padrao;
+    uint n = gravado ? entrada->tamanho : strlen(padrao);
+
+    if (n > 0 && origem[n - 1] == '\0')
+        n--;
+    if (n >= tamanho)
+        n = tamanho - 1;
+    memcpy(texto, origem, n);
+    texto[n] = '\0';
+    return gravado;
+}
+
+/**
+ * Copia os contadores do armazenamento.
+ */
+void config_get_stats(config_stats_t *stats) {
+    *stats = estado;
+}
@@ -0,0 +1,98 @@
+#include "lib/decibel.h"  // log2 e dB em ponto fixo
+#include <string.h>
+
+// 10 * log10(2) * 1000 em Q32: converte log2 Q16 em 0,001 dB com um produto
+#define LOG2_Q16_PARA_MDB_Q32 197283018
+
+// log2(1 + i / 256) em Q16, i = 0..256: 257 entradas para interpolar entre
+// vizinhas sem caso especial no fim
+static const uint32_t log2_tabela[257] = {
+        0,   369,   736,  1102,  1466,  1829,  2190,  2551,
+     2909,  3267,  3623,  3978,  4331,  4683,  5034,  5384,
+     5732,  6079,  6425,  6769,  7112,  7454,  7795,  8134,
+     8473,  8810,  9146,  9480,  9814, 10146, 10477, 10807,
+    11136, 11464, 11791, 12116, 12440, 12764, 13086, 13407,
+    13727, 14046, 14363, 14680, 14996, 15310, 15624, 15937,
+    16248, 16559, 16868, 17177, 17484, 17791, 18096, 18401,
+    18704, 19007, 19308, 19609, 19909, 20207, 20505, 20802,
+    21098, 21393, 21687, 21980, 22272, 22564, 22854, 23144,
+    23433, 23720, 24007, 24293, 24579, 24863, 25146, 25429,
+    25711, 25992, 26272, 26551, 26830, 27108, 27384, 27660,
+    27936, 28210, 28484, 28757, 29029, 29300, 29571, 29840,
+    30109, 30378, 30645, 30912, 31178, 31443, 31707, 31971,
+    32234, 32496, 32758, 33019, 33279, 33538, 33797, 34055,
+    34312, 34569, 34825, 35080, 35334, 35588, 35841, 36094,
+    36346, 36597, 36847, 37097, 37346, 37595, 37842, 38090,
+    38336, 38582, 38827, 39072, 39316, 39559, 39802, 40044,
+    40286, 40527, 40767, 41006, 41246, 41484, 41722, 41959,
+    42196, 42432, 42667, 42902, 43137, 43370, 43603, 43836,
+    44068, 44300, 44530, 44761, 44990, 45220, 45448, 45676,
+    45904, 46131, 46357, 46583, 46809, 47034, 47258, 47482,
+    47705, 47928, 48150, 48372, 48593, 48813, 49034, 49253,
+    49472, 49691, 49909, 50127, 50344, 50560, 50776, 50992,
+    51207, 51422, 51636, 51850, 52063, 52276, 52488, 52700,
+    52911, 53122, 53332, 53542, 53751, 53960, 54169, 54377,
+    54584, 54791, 54998, 55204, 55410, 55615, 55820, 56025,
+    56229, 56432, 56635, 56838, 57040, 57242, 57443, 57644,
+    57845, 58045, 58245, 58444, 58643, 58841, 59039, 59237,
+    59434, 59631, 59827, 60023, 60219, 60414, 60609, 60803,
+    60997, 61190, 61384, 61576, 61769, 61961, 62152, 62343,
+    62534, 62725, 62915, 63104, 63294, 63483, 63671, 63859,
+    64047, 64234, 64421, 64608, 64794, 64980, 65166, 65351,
+    65536
+};
+
+/**
+ * log2 da mantissa normalizada (bit 63 = 1, representando 1,xxx) em Q16:
+ * os 8 bits após o inteiro indexam a tabela e os 16 seguintes interpolam.
+ * O erro da interpolação linear fica abaixo de 3e-6 (1e-5 dB).
+ */
+static inline int32_t log2_mantissa(uint64_t mantissa) {
+    uint32_t i = (uint32_t)(mantissa >> 55) & 0xFF;
+    uint32_t fracao = (uint32_t)(mantissa >> 39) & 0xFFFF;
+    uint32_t a = log2_tabela[i], b = log2_tabela[i + 1];
+    return (int32_t)(a + (((b - a) * fracao + 0x8000) >> 16));
+}
+
+/**
+ * log2(x) em Q16 para um inteiro de 64 bits (x > 0): posição do bit mais
+ * alto pela contagem de zeros à esquerda, mais a tabela para a fração.
+ * Retorna INT32_MIN para x = 0.
+ */
+int32_t log2_q16(uint64_t x) {
+    if (x == 0)
+        return INT32_MIN;
+    int e = 63 - __builtin_clzll(x);
+    return (e << LOG2_FRAC_BITS) + log2_mantissa(x << (63 - e));
+}
+
+/**
+ * log2(x) em Q16 para um float positivo, lido direto dos bits (expoente e
+ * mantissa), sem log2f. Retorna INT32_MIN para x <= 0 e subnormais.
+ */
+int32_t log2_q16_float(float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    int32_t e = (int32_t)((bits >> 23) & 0xFF);
+    if ((bits >> 31) || e == 0)
+        return INT32_MIN;
+    uint64_t mantissa = ((uint64_t)(bits | 0x800000u) << 40);  // Bit 23 (o 1 implícito) no bit 63
+    return ((e - 127) * (1 << LOG2_FRAC_BITS)) + log2_mantissa(mantissa);
+}
+
+/**
+ * Converte log2 em Q16 para 10 * log10 em milésimos de dB (arredondado).
+ */
+int32_t log2_q16_para_mdb(int32_t log2) {
+    if (log2 == INT32_MIN)
+        return DECIBEL_MDB_ZERO;
+    return (int32_t)(((int64_t)log2 * LOG2_Q16_PARA_MDB_Q32 + (1ll << 31)) >> 32);
+}
+
+/**
+ * 10 * log10(x) em milésimos de dB, para potências e médias quadráticas
+ * inteiras. Retorna DECIBEL_MDB_ZERO para x = 0.
+ */
+int32_t potencia_para_mdb(uint64_t x) {
+    return log2_q16_para_mdb(log2_q16(x));
+}
@@ -0,0 +1,255 @@
+#include "lib/decimador.h"  // CIC + FIR de compensação
+#include "lib/microfone.h"  // Bias, saturação e formato interno das amostras
+#include <math.h>
+#include <string.h>
+
+#define DECIMADOR_KAISER_BETA 6.f  // ~63 dB de rejeição no FIR
+#define DECIMADOR_PONTOS 256       // Pontos da integração numérica no projeto do FIR
+
+/**
+ * Ganho do CIC (potência de DECIMADOR_ESTAGIOS do fator).
+ */
+static uint32_t cic_ganho(uint32_t fator_cic) {
+    uint32_t ganho = 1;
+    for (uint i = 0; i < DECIMADOR_ESTAGIOS; ++i)
+        ganho *= fator_cic;
+    return ganho;
+}
+
+/**
+ * Módulo da resposta do CIC normalizada (ganho 1 em DC), com f relativa à
+ * taxa de saída do CIC.
+ */
+static float cic_resposta(uint32_t fator_cic, float f) {
+    if (f == 0.f)
+        return 1.f;
+    float r = sinf((float)M_PI * f) / (fator_cic * sinf((float)M_PI * f / fator_cic));
+    return powf(fabsf(r), DECIMADOR_ESTAGIOS);
+}
+
+/**
+ * Função de Bessel modificada I0 (série), para a janela de Kaiser.
+ */
+static float bessel_i0(float x) {
+    float soma = 1.f, termo = 1.f;
+    for (uint k = 1; k < 20; ++k) {
+        termo *= (x / (2.f * k)) * (x / (2.f * k));
+        soma += termo;
+    }
+    return soma;
+}
+
+/**
+ * Projeta o FIR de compensação (ganho 1 em DC) na taxa de saída do CIC:
+ * passa-baixas ideal com corte na metade da banda (a taxa final é a metade
+ * desta) e resposta 1 / CIC(f) dentro dela, por amostragem em frequência,
+ * com janela de Kaiser.
+ */
+static void decimador_projetar(uint32_t fator_cic, float *h) {
+    const int centro = DECIMADOR_TAPS / 2;
+    const float corte = 0.25f;  // Relativo à taxa de saída do CIC
+    float soma = 0.f;
+
+    for (int n = 0; n < DECIMADOR_TAPS; ++n) {
+        float acumulado = 0.f;
+        for (int k = 0; k < DECIMADOR_PONTOS; ++k) {
+            float f = (k + 0.5f) * corte / DECIMADOR_PONTOS;
+            acumulado += cosf(2.f * (float)M_PI * f * (n - centro)) / cic_resposta(fator_cic, f);
+        }
+        float r = (float)(n - centro) / centro;
+        float janela = bessel_i0(DECIMADOR_KAISER_BETA * sqrtf(1.f - r * r)) / bessel_i0(DECIMADOR_KAISER_BETA);
+        h[n] = acumulado * janela;
+        soma += h[n];
+    }
+    for (int n = 0; n < DECIMADOR_TAPS; ++n)
+        h[n] /= soma;
+}
+
+/**
+ * Prepara o decimador para o fator total dado (par, de 4 a 2 * DECIMADOR_CIC_MAX).
+ * Usa ponto flutuante só aqui.
+ */
+void decimador_init(decimador_t *d, uint32_t fator) {
+    hard_assert(fator % 2 == 0 && fator >= 4 && fator / 2 <= DECIMADOR_CIC_MAX);
+    d->fator_cic = fator / 2;
+
+    // Saída do CIC = código * ganho; o shift deixa de 16 a 32 vezes o código
+    // (4 bits fracionários ou um pouco mais) e o FIR absorve o resto do ganho
+    const uint32_t ganho = cic_ganho(d->fator_cic);
+    d->ganho_cic = ganho;
+    d->linearizacao = NULL;
+    d->desloca_codigos = d->desloca = (31 - __builtin_clz(ganho)) - AUDIO_FRAC_BITS;
+    decimador_set_bias(d, ADC_BIAS_CODE << AUDIO_FRAC_BITS);
+    const float resto = (float)(1u << (d->desloca + AUDIO_FRAC_BITS)) / ganho;
+
+    float h[DECIMADOR_TAPS];
+    decimador_projetar(d->fator_cic, h);
+    for (uint k = 0; k <= DECIMADOR_TAPS / 2; ++k)
+        d->coef[k] = (int32_t)lroundf(h[k] * resto * 16384.f);
+
+    decimador_reiniciar(d);
+}
+
+/**
+ * Define o nível DC removido na saída do CIC, em códigos do ADC com
+ * AUDIO_FRAC_BITS bits fracionários (o padrão é ADC_BIAS_CODE).
+ */
+void decimador_set_bias(decimador_t *d, int32_t bias) {
+    d->bias = bias;
+    if (d->linearizacao != NULL)
+        d->bias_cic = (uint32_t)bias * d->ganho_cic;  // Entrada já com os bits fracionários
+    else
+        d->bias_cic = (uint32_t)(((uint64_t)bias * d->ganho_cic) >> AUDIO_FRAC_BITS);
+}
+
+/**
+ * Liga (tabela de ADC_CODIGO_MAX + 1 valores com AUDIO_FRAC_BITS bits
+ * fracionários) ou desliga (NULL) a linearização dos códigos na entrada do
+ * CIC. Reinicia o decimador: a troca de escala não se mistura ao histórico.
+ */
+void decimador_set_linearizacao(decimador_t *d, const uint16_t *tabela) {
+    d->linearizacao = tabela;
+    d->desloca = d->desloca_codigos + (tabela != NULL ? AUDIO_FRAC_BITS : 0);
+    decimador_set_bias(d, d->bias);
+    decimador_reiniciar(d);
+}
+
+/**
+ * Zera os integradores, os pentes e o histórico do FIR.
+ */
+void decimador_reiniciar(decimador_t *d) {
+    d->fase = 0;
+    d->pos = 0;
+    d->impar = false;
+    memset(d->integrador, 0, sizeof(d->integrador));
+    memset(d->pente, 0, sizeof(d->pente));
+    memset(d->historico, 0, sizeof(d->historico));
+}
+
+/**
+ * Integradores do CIC sobre entrada[inicio .. fim - 1], contando as
+ * amostras saturadas. Com tabela, soma o valor linearizado do código; é
+ * expandida em cada chamada, então o caso sem tabela não paga o teste.
+ */
+static inline __attribute__((always_inline))
+void cic_integrar(uint32_t *integrador, const uint16_t *entrada, uint inicio, uint fim,
+                  const uint16_t *tabela, uint32_t *sat_min, uint32_t *sat_max) {
+    uint32_t i0 = integrador[0], i1 = integrador[1], i2 = integrador[2], i3 = integrador[3];
+    for (uint i = inicio; i < fim; ++i) {
+        uint32_t codigo = entrada[i];
+        if (codigo - 1u >= ADC_CODIGO_MAX - 1u) {  // Só 0 e ADC_CODIGO_MAX caem aqui
+            if (codigo == 0)
+                (*sat_min)++;
+            else
+                (*sat_max)++;
+        }
+        i0 += tabela != NULL ? tabela[codigo] : codigo;
+        i1 += i0;
+        i2 += i1;
+        i3 += i2;
+    }
+    integrador[0] = i0;
+    integrador[1] = i1;
+    integrador[2] = i2;
+    integrador[3] = i3;
+}
+
+/**
+ * Decima n códigos do ADC para o formato interno de áudio e conta, na mesma
+ * passada, as amostras saturadas (0 e ADC_CODIGO_MAX). Retorna quantas
+ * amostras foram escritas em saida (n / fator, se n for múltiplo do fator).
+ *
+ * Os integradores rodam na taxa do ADC e somam o código (cru ou
+ * linearizado): o bias vira uma constante na saída do CIC e é removido
+ * depois dos pentes.
+ */
+uint decimador_processar(decimador_t *d, const uint16_t *entrada, uint n, int32_t *saida,
+                         uint32_t *saturadas_min, uint32_t *saturadas_max) {
+    uint32_t integrador[DECIMADOR_ESTAGIOS];
+    memcpy(integrador, d->integrador, sizeof(integrador));
+    uint32_t sat_min = 0, sat_max = 0;
+    uint produzidas = 0;
+    uint i = 0;
+
+    while (i < n) {
+        // Integradores até completar uma saída do CIC
+        uint fim = i + (d->fator_cic - d->fase);
+        if (fim > n)
+            fim = n;
+        d->fase += fim - i;
+        if (d->linearizacao != NULL)
+            cic_integrar(integrador, entrada, i, fim, d->linearizacao, &sat_min, &sat_max);
+        else
+            cic_integrar(integrador, entrada, i, fim, NULL, &sat_min, &sat_max);
+        i = fim;
+        if (d->fase < d->fator_cic)
+            break;
+        d->fase = 0;
+
+        // Pentes na taxa de saída do CIC
+        uint32_t y = integrador[DECIMADOR_ESTAGIOS - 1], t;
+        t = y - d->pente[0]; d->pente[0] = y; y = t;
+        t = y - d->pente[1]; d->pente[1] = y; y = t;
+        t = y - d->pente[2]; d->pente[2] = y; y = t;
+        t = y - d->pente[3]; d->pente[3] = y; y = t;
+        int32_t x = (int32_t)(y - d->bias_cic) >> d->desloca;
+
+        // Histórico duplicado: a janela historico[pos .. pos + TAPS - 1] fica contígua
+        d->historico[d->pos] = d->historico[d->pos + DECIMADOR_TAPS] = x;
+        if (++d->pos == DECIMADOR_TAPS)
+            d->pos = 0;
+
+        d->impar = !d->impar;
+        if (d->impar)
+            continue;
+
+        // FIR simétrico: soma os pares antes de multiplicar
+        const int32_t *w = &d->historico[d->pos];
+        int32_t soma = d->coef[DECIMADOR_TAPS / 2] * w[DECIMADOR_TAPS / 2];
+        for (uint k = 0; k < DECIMADOR_TAPS / 2; ++k)
+            soma += d->coef[k] * (w[k] + w[DECIMADOR_TAPS - 1 - k]);
+        saida[produzidas++] = (soma + (1 << 13)) >> 14;
+    }
+
+    memcpy(d->integrador, integrador, sizeof(integrador));
+    *saturadas_min += sat_min;
+    *saturadas_max += sat_max;
+    return produzidas;
+}
+
+/**
+ * Ganho de bits efetivos (ENOB) do decimador para ruído branco na entrada:
+ * -0,5 * log2 da soma dos quadrados da resposta ao impulso completa (CIC
+ * seguido do FIR, ganho 1 em DC). Para uma média simples de R amostras
+ * daria 0,5 * log2(R).
+ */
+float decimador_ganho_enob(uint32_t fator) {
+    const uint32_t r = fator / 2;
+    float h[DECIMADOR_TAPS];
+    decimador_projetar(r, h);
+
+    // Resposta ao impulso do CIC normalizado: caixa de r amostras convoluída DECIMADOR_ESTAGIOS vezes
+    float cic[DECIMADOR_ESTAGIOS * (DECIMADOR_CIC_MAX - 1) + 1] = {1.f};
+    uint tamanho = 1;
+    for (uint e = 0; e < DECIMADOR_ESTAGIOS; ++e) {
+        for (int n = tamanho + r - 2; n >= 0; --n) {
+            float s = 0.f;
+            for (uint j = 0; j < r; ++j)
+                if (n - (int)j >= 0 && n - (int)j < (int)tamanho)
+                    s += cic[n - j];
+            cic[n] = s / r;
+        }
+        tamanho += r - 1;
+    }
+
+    // Resposta completa na taxa do ADC: h_total[n] = soma_k h[k] * cic[n - k * r]
+    float energia = 0.f;
+    for (uint n = 0; n < tamanho + (DECIMADOR_TAPS - 1) * r; ++n) {
+        float s = 0.f;
+        for (uint k = 0; k < DECIMADOR_TAPS; ++k)
+            if (n >= k * r && n - k * r < tamanho)
+                s += h[k] * cic[n - k * r];
+        energia += s * s;
+    }
+    return -0.5f * log2f(energia);
+}
@@ -2,6 +2,13 @@
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 #include "inc/ssd1306.h"
+#include "lib/agendador.h"  // Espera dormindo em vez de busy-wait
+#include "lib/perfil.h"  // Tempo de cada texto
+#include "lib/transporte_i2c.h"  // Quadros enviados por DMA
+#include "lib/texto.h"  // Texto direto nos bytes das páginas
+#include "lib/grafico.h"  // Linhas, barras e histórico
+#include "lib/tela.h"  // Telas retidas (widgets)
+#include "lib/display_oled.h"
 
 // Definições do barramento I2C e pinos de conexão do display OLED
 #define I2C_PORT i2c1
@@ -10,99 +17,307 @@
 
 ssd1306_t disp; // Estrutura do display OLED
 
-// Função de temporizador que substitui sleep_ms
-void timer_milliseconds(int milliseconds) {
-    uint64_t start_time = time_us_64(); // Obtém o tempo atual em microssegundos
-    uint64_t delay = milliseconds * 1000; // Converte milissegundos para microssegundos
+// Cópia do que o painel está mostrando: cada envio manda só as colunas que mudaram
+static uint8_t exibido[DISPLAY_PAGINAS * DISPLAY_LARGURA];
+static volatile bool exibido_valido = false;  // Falso até o primeiro envio completo (ou depois de erro no I2C)
+// Quadro em trânsito: as janelas copiadas do desenho em palavras do I2C, que o
+// DMA envia enquanto o próximo quadro já é desenhado em disp.buffer
+static uint16_t palavras[DISPLAY_PALAVRAS_QUADRO];
+static uint num_palavras;
+static display_stats_t stats;
 
-    // Aguarda até que o tempo especificado tenha passado
-    while (time_us_64() - start_time < delay) {
-        // Loop vazio (busy-wait)
-    }
+// Função de temporizador que substitui sleep_ms (o núcleo dorme até o alarme)
+void timer_milliseconds(int milliseconds) {
+    agendador_dormir_us((uint64_t)milliseconds * 1000);
 }
 
 // Função para inicializar o sistema e o display OLED
 void inicializa(){
     stdio_init_all(); // Inicializa a comunicação padrão
-    i2c_init(I2C_PORT, 400*1000); // Inicializa o I2C com frequência de 400kHz
-    gpio_set_function(PINO_SCL, GPIO_FUNC_I2C);
-    gpio_set_function(PINO_SDA, GPIO_FUNC_I2C);
-    gpio_pull_up(PINO_SCL);
-    gpio_pull_up(PINO_SDA);
+    transporte_i2c_init(I2C_PORT, PINO_SDA, PINO_SCL, DISPLAY_I2C_HZ); // I2C, DMA e interrupção do envio dos quadros
     disp.external_vcc = false; // Usa a alimentação interna do OLED
-    ssd1306_init(&disp, 128, 64, 0x3C, I2C_PORT); // Inicializa o display OLED
+    ssd1306_init(&disp, DISPLAY_LARGURA, DISPLAY_PAGINAS * 8, 0x3C, I2C_PORT); // Inicializa o display OLED
+    exibido_valido = false;
+}
+
+// Fim do envio de um quadro (na interrupção do I2C): em erro o conteudo do
+// painel fica incerto e o proximo quadro vai inteiro
+static void fim_quadro(bool ok, void *dados) {
+    (void)dados;
+    if (!ok) {
+        exibido_valido = false;
+        stats.erros++;
+    }
+}
+
+// Acrescenta ao quadro a janela de paginas p0..p1 e colunas c0..c1: uma
+// transacao com os seis comandos de endereco e outra com os dados
+static void montar_janela(uint p0, uint p1, uint c0, uint c1) {
+    uint16_t *p = palavras + num_palavras;
+    *p++ = TRANSPORTE_I2C_DADO(0x00);  // Comandos
+    *p++ = TRANSPORTE_I2C_DADO(SET_COL_ADDR);
+    *p++ = TRANSPORTE_I2C_DADO(c0);
+    *p++ = TRANSPORTE_I2C_DADO(c1);
+    *p++ = TRANSPORTE_I2C_DADO(SET_PAGE_ADDR);
+    *p++ = TRANSPORTE_I2C_DADO(p0);
+    *p++ = TRANSPORTE_I2C_FIM(p1);
+    *p++ = TRANSPORTE_I2C_DADO(0x40);  // Dados da RAM do display
+    for (uint pagina = p0; pagina <= p1; ++pagina) {
+        const uint8_t *linha = disp.buffer + pagina * DISPLAY_LARGURA;
+        for (uint coluna = c0; coluna <= c1; ++coluna)
+            *p++ = TRANSPORTE_I2C_DADO(linha[coluna]);
+    }
+    p[-1] |= TRANSPORTE_I2C_FIM(0);
+    stats.bytes_ultimo += DISPLAY_BYTES_JANELA + (p1 - p0 + 1) * (c1 - c0 + 1);
+    stats.janelas++;
+    num_palavras = p - palavras;
+}
+
+// Envia ao display o quadro desenhado desde o ultimo envio, so com o que mudou.
+// Compara cada pagina com o que o painel mostra e escolhe o mais barato entre
+// uma janela por pagina alterada e uma janela unica cobrindo todas. O envio
+// segue por DMA depois do retorno; se o anterior ainda estiver em andamento,
+// espera por ele antes de comparar
+void display_atualizar() {
+    uint64_t inicio = time_us_64();
+    transporte_i2c_esperar();
+
+    int c0[DISPLAY_PAGINAS], c1[DISPLAY_PAGINAS];
+    int p_min = -1, p_max = -1, c_min = DISPLAY_LARGURA, c_max = -1;
+    uint32_t custo_paginas = 0;
+
+    for (uint pagina = 0; pagina < DISPLAY_PAGINAS; ++pagina) {
+        const uint8_t *novo = disp.buffer + pagina * DISPLAY_LARGURA;
+        const uint8_t *antigo = exibido + pagina * DISPLAY_LARGURA;
+        int a = 0, b = DISPLAY_LARGURA - 1;
+        if (exibido_valido) {
+            while (a < DISPLAY_LARGURA && novo[a] == antigo[a])
+                ++a;
+            while (b > a && novo[b] == antigo[b])
+                --b;
+        }
+        c0[pagina] = a;
+        c1[pagina] = b;
+        if (a >= DISPLAY_LARGURA)
+            continue;  // Pagina sem mudanca
+        if (p_min < 0)
+            p_min = pagina;
+        p_max = pagina;
+        if (a < c_min)
+            c_min = a;
+        if (b > c_max)
+            c_max = b;
+        custo_paginas += DISPLAY_BYTES_JANELA + (b - a + 1);
+    }
+
+    stats.bytes_ultimo = 0;
+    stats.janelas = 0;
+    num_palavras = 0;
+    if (p_min >= 0) {
+        uint32_t custo_unico = DISPLAY_BYTES_JANELA + (uint32_t)(p_max - p_min + 1) * (c_max - c_min + 1);
+        if (custo_unico <= custo_paginas) {
+            montar_janela(p_min, p_max, c_min, c_max);
+        } else {
+            for (int pagina = p_min; pagina <= p_max; ++pagina) {
+                if (c0[pagina] < DISPLAY_LARGURA)
+                    montar_janela(pagina, pagina, c0[pagina], c1[pagina]);
+            }
+        }
+    }
+
+    // A copia passa a valer ao enfileirar; fim_quadro a invalida se o envio falhar
+    memcpy(exibido, disp.buffer, sizeof(exibido));
+    exibido_valido = true;
+    if (num_palavras > 0 && !transporte_i2c_enviar(disp.address, palavras, num_palavras, fim_quadro, NULL)) {
+        exibido_valido = false;
+        stats.erros++;
+    }
+
+    uint32_t tempo = (uint32_t)(time_us_64() - inicio);
+    stats.quadros++;
+    stats.bytes_total += stats.bytes_ultimo;
+    stats.tempo_ultimo_us = tempo;
+    stats.tempo_total_us += tempo;
+    if (tempo > stats.tempo_max_us)
+        stats.tempo_max_us = tempo;
+    perfil_fim(PERFIL_OLED_ENVIO, inicio);
+}
+
+// Espera o quadro em transito chegar ao painel (antes de usar o I2C de forma bloqueante)
+void display_esperar() {
+    transporte_i2c_esperar();
+}
+
+// Esquece a copia do painel: o proximo display_atualizar envia o quadro inteiro
+void display_invalidar() {
+    display_esperar();
+    exibido_valido = false;
+}
+
+// Copia os contadores de envio ao display
+void display_get_stats(display_stats_t *saida) {
+    *saida = stats;
+}
+
+// Imprime bytes e tempo medios por quadro, comparados ao envio do buffer
+// inteiro, e o tempo dos envios no barramento
+void display_relatorio() {
+    if (stats.quadros == 0)
+        return;
+    printf("[DISPLAY] %u quadros: media %u bytes/quadro (ultimo %u, buffer inteiro %u), media %u us, max %u us de CPU, %u erros\n",
+           (unsigned)stats.quadros, (unsigned)(stats.bytes_total / stats.quadros), (unsigned)stats.bytes_ultimo,
+           (unsigned)DISPLAY_BYTES_QUADRO_INTEIRO, (unsigned)(stats.tempo_total_us / stats.quadros),
+           (unsigned)stats.tempo_max_us, (unsigned)stats.erros);
+    transporte_i2c_stats_t t;
+    transporte_i2c_get_stats(&t);
+    printf("[DISPLAY] I2C %u Hz por DMA: %u envios, ultimo %u us, max %u us no barramento, %u erros, %u recuperacoes\n",
+           (unsigned)t.baudrate, (unsigned)t.transferencias, (unsigned)t.tempo_ultimo_us, (unsigned)t.tempo_max_us,
+           (unsigned)t.erros, (unsigned)t.recuperacoes);
 }
 
-// Função para exibir um texto na tela OLED
+// Função para desenhar um texto no quadro (aparece no proximo display_atualizar)
 void print_texto(char *msg, uint32_t x, uint32_t y, uint32_t scale) {
-    ssd1306_draw_string(&disp, x, y, scale, msg); // Desenha o texto na posição e escala escolhidas
-    ssd1306_show(&disp); // Atualiza o display para exibir o texto
+    uint64_t inicio = perfil_inicio();
+    texto_desenhar(&disp, x, y, scale, msg); // Desenha o texto na posição e escala escolhidas
+    perfil_fim(PERFIL_OLED_TEXTO, inicio);
 }
 
 // Função para limpar a tela do display OLED
 void limpar_tela(){
     ssd1306_clear(&disp); // Limpa a tela
+    tela_invalidar(); // A tela retida precisa ser redesenhada
 }
 
-// Função para desenhar uma linha no display OLED
+// Função para desenhar uma linha no quadro
 void print_linha(int x1, int y1, int x2, int y2){
-    ssd1306_draw_line(&disp, x1, y1, x2, y2); // Desenha uma linha entre dois pontos
-    ssd1306_show(&disp); // Atualiza o display
+    grafico_linha(&disp, x1, y1, x2, y2); // Desenha uma linha entre dois pontos
 }
 
-// Função para desenhar um retângulo no display OLED
+// Função para desenhar um retângulo no quadro
 void print_retangulo(int x1, int y1, int x2, int y2){
-    ssd1306_draw_empty_square(&disp, x1, y1, x2, y2); // Desenha um retângulo vazio
-    ssd1306_show(&disp); // Atualiza o display
+    grafico_contorno(&disp, x1, y1, x2, y2); // Desenha um retângulo vazio
 }
 
+// Telas retidas: os titulos ficam na camada de fundo e so os valores sao redesenhados
+enum { CARREGANDO_TITULO1, CARREGANDO_TITULO2, CARREGANDO_STATUS, CARREGANDO_BARRA };
+static widget_t carregando_widgets[] = {
+    [CARREGANDO_TITULO1] = TELA_ROTULO(1, 1, 2, "SOUND"),
+    [CARREGANDO_TITULO2] = TELA_ROTULO(20, 17, 2, "MONITOR"),
+    [CARREGANDO_STATUS] = TELA_ROTULO(20, 33, 1, "Inicializando..."),
+    [CARREGANDO_BARRA] = TELA_BARRA(5, 52, 118, 8, 0.f, 100.f),
+};
+static tela_t tela_carregando = TELA(carregando_widgets);
+
+enum { PRONTO_TITULO1, PRONTO_TITULO2, PRONTO_STATUS };
+static widget_t pronto_widgets[] = {
+    [PRONTO_TITULO1] = TELA_ROTULO(1, 1, 2, "SOUND"),
+    [PRONTO_TITULO2] = TELA_ROTULO(20, 17, 2, "MONITOR"),
+    [PRONTO_STATUS] = TELA_ROTULO(25, 40, 2, "Pronto!"),
+};
+static tela_t tela_pronto = TELA(pronto_widgets);
+
+enum { DESLIGANDO_TITULO1, DESLIGANDO_TITULO2, DESLIGANDO_STATUS };
+static widget_t desligando_widgets[] = {
+    [DESLIGANDO_TITULO1] = TELA_ROTULO(1, 1, 2, "SOUND"),
+    [DESLIGANDO_TITULO2] = TELA_ROTULO(20, 17, 2, "MONITOR"),
+    [DESLIGANDO_STATUS] = TELA_TEXTO(30, 40, 1, 98),
+};
+static tela_t tela_desligando = TELA(desligando_widgets);
+
+enum { NIVEL_TITULO1, NIVEL_TITULO2, NIVEL_VOLUME, NIVEL_DB };
+static widget_t nivel_widgets[] = {
+    [NIVEL_TITULO1] = TELA_ROTULO(1, 5, 2, "SOUND"),
+    [NIVEL_TITULO2] = TELA_ROTULO(20, 20, 2, "MONITOR"),
+    [NIVEL_VOLUME] = TELA_TEXTO(5, 40, 1, 123),
+    [NIVEL_DB] = TELA_TEXTO(5, 50, 1, 123),
+};
+static tela_t tela_nivel = TELA(nivel_widgets);
+
 // Função para exibir a barra de carregamento
 void exibir_barra_carregamento(int porcentagem) {
-    char barra[12] = "[          ]"; // Representação gráfica da barra de carregamento
-    int posicoes_preenchidas = porcentagem / 10;
+    tela_barra(&tela_carregando, CARREGANDO_BARRA, (float)porcentagem);
+    tela_mostrar(&tela_carregando);
+}
 
-    // Preenche a barra conforme a porcentagem
-    for (int i = 1; i <= posicoes_preenchidas; i++) {
-        barra[i] = '#';
-    }
+// Função para exibir um passo da animação de desligamento (os pontos crescem em ciclo)
+void exibir_tela_desligar(int passo) {
+    static const char *pontos[] = {"Desligando.", "Desligando..", "Desligando..."};
+    tela_texto(&tela_desligando, DESLIGANDO_STATUS, pontos[passo % 3]);
+    tela_mostrar(&tela_desligando);
+}
+
+// Função para exibir a tela de pronto
+void exibir_tela_pronto(void) { 
+    tela_mostrar(&tela_pronto);
+}
+
+// Tela normal das medicoes: so a classificacao e o nivel mudam
+void exibir_tela_nivel(const char *volume_str, const char *db_str) {
+    tela_texto(&tela_nivel, NIVEL_VOLUME, volume_str);
+    tela_texto(&tela_nivel, NIVEL_DB, db_str);
+    tela_mostrar(&tela_nivel);
+}
 
-    // Atualiza o display OLED com a barra de carregamento
+// Função para exibir o alerta de microfonia com a frequência detectada
+void exibir_alerta_microfonia(float frequencia) {
+    char freq_str[16];
+    sprintf(freq_str, "%.0f Hz", frequencia);
     limpar_tela();
-    print_texto("SOUND", 1, 1, 2); // Título 1
-    print_texto("MONITOR", 20, 17, 2); // Título 2
-    print_texto("Inicializando...", 20, 33, 1); // Mensagem de status
-    print_texto(barra, 5, 52, 1); // Barra de carregamento gráfica
-    char porcentagem_str[16];
-    sprintf(porcentagem_str, "%d%%", porcentagem); // Converte a porcentagem para string
+    print_texto("MICROFONIA", 1, 5, 2);
+    print_texto("Frequencia:", 5, 30, 1);
+    print_texto(freq_str, 5, 42, 2);
+    display_atualizar();
 }
 
-// Função para exibir a tela de desligamento
-void exibir_tela_desligar(void) {
-    for (int i = 0; i < 2; i++) {
-        limpar_tela();
-        print_texto("SOUND", 1, 1, 2);
-        print_texto("MONITOR", 20, 17, 2);
-        print_texto("Desligando.", 30, 40, 1);
-        timer_milliseconds(520);
+// Função para exibir a calibração de campo: nível do calibrador e o passo atual
+void exibir_tela_calibracao(float nivel_db, const char *estado) {
+    char nivel_str[16];
+    sprintf(nivel_str, "%.1f dB", nivel_db);
+    limpar_tela();
+    print_texto("CALIBRACAO", 1, 5, 2);
+    print_texto(nivel_str, 5, 30, 1);
+    print_texto((char *)estado, 5, 45, 1);
+    display_atualizar();
+}
+
+// Tela do historico: texto do nivel na pagina 0, barra do nivel atual na
+// pagina 1 e o historico nas paginas 2 a 7. Com completo (outra tela estava
+// no quadro) redesenha tudo; senao so o texto, a barra e os pontos novos
+void exibir_tela_historico(grafico_historico_t *historico, const char *nivel_str, float nivel_db, bool completo) {
+    if (completo)
         limpar_tela();
-        print_texto("SOUND", 1, 1, 2);
-        print_texto("MONITOR", 20, 17, 2);
-        print_texto("Desligando..", 30, 40, 1);
-        timer_milliseconds(520);
+    grafico_preencher(&disp, 0, 0, DISPLAY_LARGURA, 8, false);
+    print_texto((char *)nivel_str, 0, 0, 1);
+    grafico_barra(&disp, 0, 9, DISPLAY_LARGURA, 6, nivel_db, HISTORICO_DB_MIN, HISTORICO_DB_MAX);
+    grafico_historico_desenhar(&disp, historico, completo);
+    display_atualizar();
+}
+
+// Tela do espectro: texto e barra do nivel como no historico, uma barra
+// vertical por banda de oitava (0,1 dB) e a frequencia de uma banda sim,
+// outra nao, na pagina 7. As barras sao redesenhadas a cada medicao; o envio
+// por diferenca manda so as colunas que mudaram
+void exibir_tela_espectro(const int16_t *oitava_ddb, uint bandas, const char *nivel_str, float nivel_db, bool completo) {
+    static const char *rotulos[] = {"31", "125", "500", "2k", "8k"};  // Bandas 0, 2, 4, 6 e 8
+    const int passo = DISPLAY_LARGURA / bandas;
+    const int altura = DISPLAY_PAGINAS * 8 - 8 - ESPECTRO_Y;
+
+    if (completo) {
         limpar_tela();
-        print_texto("SOUND", 1, 1, 2);
-        print_texto("MONITOR", 20, 17, 2);
-        print_texto("Desligando...", 30, 40, 1);
-        timer_milliseconds(520);
+        for (uint b = 0; b < bandas; b += 2) {
+            if (b / 2 < sizeof(rotulos) / sizeof(rotulos[0]))
+                print_texto((char *)rotulos[b / 2], b * passo, DISPLAY_PAGINAS * 8 - 8, 1);
+        }
     }
-}
+    grafico_preencher(&disp, 0, 0, DISPLAY_LARGURA, 8, false);
+    print_texto((char *)nivel_str, 0, 0, 1);
+    grafico_barra(&disp, 0, 9, DISPLAY_LARGURA, 6, nivel_db, HISTORICO_DB_MIN, HISTORICO_DB_MAX);
 
-// Função para exibir a tela de pronto
-void exibir_tela_pronto(void) { 
-    limpar_tela();
-    print_texto("SOUND", 1, 1, 2);
-    print_texto("MONITOR", 20, 17, 2);
-    print_texto("Pronto!", 25, 40, 2);
-    timer_milliseconds(500); // Aguarda 0.5 segundo antes de continuar
+    for (uint b = 0; b < bandas; ++b) {
+        float fracao = (oitava_ddb[b] / 10.f - ESPECTRO_DB_MIN) / (ESPECTRO_DB_MAX - ESPECTRO_DB_MIN);
+        int cheio = fracao <= 0.f ? 0 : fracao >= 1.f ? altura : (int)(fracao * altura + 0.5f);
+        grafico_preencher(&disp, b * passo, ESPECTRO_Y, passo - 2, altura - cheio, false);
+        grafico_preencher(&disp, b * passo, ESPECTRO_Y + altura - cheio, passo - 2, cheio, true);
+    }
+    display_atualizar();
 }
-
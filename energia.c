@@ -0,0 +1,137 @@
+#include "lib/energia.h"    // Modo de baixo consumo e contabilidade de energia
+#include "hardware/clocks.h"  // Troca do clk_sys
+#include "lib/transporte_i2c.h"  // Quadro do display ainda no barramento
+#include <stdio.h>
+
+static bool baixo_consumo = ENERGIA_BAIXO_CONSUMO_PADRAO;
+static bool captura_ligada = false;
+static bool clock_lento = false;
+
+// Estados ativos e instante em que cada um começou
+static bool ativo[ENERGIA_ESTADOS];
+static uint64_t inicio_us[ENERGIA_ESTADOS];
+static energia_stats_t stats;
+
+static const float corrente_ma[ENERGIA_ESTADOS] = {
+    [ENERGIA_CLOCK_RAPIDO] = ENERGIA_MA_CLOCK_RAPIDO,
+    [ENERGIA_CLOCK_LENTO] = ENERGIA_MA_CLOCK_LENTO,
+    [ENERGIA_CAPTURA] = ENERGIA_MA_CAPTURA,
+    [ENERGIA_WIFI_DESEMPENHO] = ENERGIA_MA_WIFI_DESEMPENHO,
+    [ENERGIA_WIFI_PADRAO] = ENERGIA_MA_WIFI_PADRAO,
+    [ENERGIA_WIFI_ECONOMIA] = ENERGIA_MA_WIFI_ECONOMIA,
+};
+
+/**
+ * Liga ou desliga um estado, somando o tempo que ele ficou ativo.
+ */
+static void estado_set(energia_estado_t estado, bool ligado) {
+    if (ativo[estado] == ligado)
+        return;
+    uint64_t agora = time_us_64();
+    if (ativo[estado])
+        stats.tempo_us[estado] += agora - inicio_us[estado];
+    ativo[estado] = ligado;
+    inicio_us[estado] = agora;
+}
+
+/**
+ * Começa a contabilidade com o clock normal, sem captura e sem Wi-Fi.
+ */
+void energia_init() {
+    for (uint e = 0; e < ENERGIA_ESTADOS; ++e)
+        ativo[e] = false;
+    estado_set(ENERGIA_CLOCK_RAPIDO, true);
+}
+
+/**
+ * Liga ou desliga o modo de baixo consumo. Ao desligar, o clock volta ao normal.
+ */
+void energia_set_baixo_consumo(bool ligado) {
+    baixo_consumo = ligado;
+    if (!ligado)
+        energia_ocioso(false);
+}
+
+/**
+ * Retorna true no modo de baixo consumo.
+ */
+bool energia_baixo_consumo() {
+    return baixo_consumo;
+}
+
+/**
+ * Gancho das esperas longas do agendador (núcleo 0). No modo de baixo
+ * consumo e com a captura pausada, passa o clk_sys (e o clk_peri) para o
+ * PLL_USB de 48 MHz e desliga o PLL_SYS; na saída, restaura o clock antes
+ * de a próxima tarefa rodar. O I2C usa o clk_sys e o quadro do display
+ * segue por DMA depois que a tarefa retorna: a troca espera o fim dele, senão
+ * o SCL cai para ~40% e o envio estoura o prazo. O ADC e o USB não mudam:
+ * usam o PLL_USB.
+ */
+void energia_ocioso(bool entrando) {
+    if (entrando && baixo_consumo && !captura_ligada && !clock_lento) {
+        transporte_i2c_esperar();
+        set_sys_clock_48mhz();
+        clock_lento = true;
+        stats.trocas_clock++;
+        estado_set(ENERGIA_CLOCK_RAPIDO, false);
+        estado_set(ENERGIA_CLOCK_LENTO, true);
+    } else if (!entrando && clock_lento) {
+        set_sys_clock_khz(ENERGIA_CLOCK_KHZ, true);
+        clock_lento = false;
+        estado_set(ENERGIA_CLOCK_LENTO, false);
+        estado_set(ENERGIA_CLOCK_RAPIDO, true);
+    }
+}
+
+/**
+ * Registra a captura ligada ou pausada (o núcleo 1 precisa do clock normal).
+ */
+void energia_captura(bool ligada) {
+    captura_ligada = ligada;
+    if (ligada)
+        energia_ocioso(false);
+    estado_set(ENERGIA_CAPTURA, ligada);
+}
+
+/**
+ * Registra o modo atual do rádio.
+ */
+void energia_wifi(energia_wifi_t modo) {
+    estado_set(ENERGIA_WIFI_DESEMPENHO, modo == ENERGIA_WIFI_MODO_DESEMPENHO);
+    estado_set(ENERGIA_WIFI_PADRAO, modo == ENERGIA_WIFI_MODO_PADRAO);
+    estado_set(ENERGIA_WIFI_ECONOMIA, modo == ENERGIA_WIFI_MODO_ECONOMIA);
+}
+
+/**
+ * Copia o tempo em cada estado até agora e a carga estimada.
+ */
+void energia_get_stats(energia_stats_t *saida) {
+    uint64_t agora = time_us_64();
+    *saida = stats;
+    saida->carga_mah = 0.f;
+    for (uint e = 0; e < ENERGIA_ESTADOS; ++e) {
+        if (ativo[e])
+            saida->tempo_us[e] += agora - inicio_us[e];
+        saida->carga_mah += corrente_ma[e] * (saida->tempo_us[e] / 3.6e9f);
+    }
+}
+
+/**
+ * Imprime o tempo em cada estado, a carga e a corrente média desde o boot.
+ */
+void energia_relatorio() {
+    static const char *nomes[ENERGIA_ESTADOS] = {"clock 125 MHz", "clock 48 MHz", "captura",
+                                                 "wifi desempenho", "wifi padrao", "wifi economia"};
+    energia_stats_t s;
+    energia_get_stats(&s);
+    float total_s = time_us_64() / 1e6f;
+
+    printf("[ENERGIA] Modo %s, %.2f mAh em %.0f s (media %.1f mA), %u trocas de clock\n",
+           baixo_consumo ? "baixo consumo" : "continuo", s.carga_mah, total_s,
+           s.carga_mah * 3600.f / total_s, (unsigned)s.trocas_clock);
+    for (uint e = 0; e < ENERGIA_ESTADOS; ++e) {
+        printf("[ENERGIA] %-16s %8.1f s (%5.1f%%)\n", nomes[e], s.tempo_us[e] / 1e6f,
+               100.f * s.tempo_us[e] / 1e6f / total_s);
+    }
+}
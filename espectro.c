@@ -0,0 +1,301 @@
+#include "lib/espectro.h"  // FFT radix-4 em Q15 e bandas de oitava / 1/3 de oitava
+#include <math.h>
+#include <string.h>  // memset
+
+// Tabelas geradas na inicialização (compartilhadas por todas as instâncias)
+static int16_t seno_q15[ESPECTRO_N + ESPECTRO_N / 4];  // sin(2*pi*i/N); cos(x) = seno[i + N/4]
+static int16_t janela_q15[ESPECTRO_N];                  // Janela de Hann
+static bool tabelas_prontas = false;
+
+// Limites para o ponto flutuante em blocos: com todos os componentes abaixo
+// do primeiro, uma borboleta radix-4 não estoura 16 bits (crescimento <=
+// 4 * sqrt(2)); abaixo do segundo basta dividir por 4, acima dele por 8
+#define FFT_LIMITE_SEM_ESCALA 5792
+#define FFT_LIMITE_ESCALA_4 23170
+
+/**
+ * Frequência central da banda de 1/3 de oitava (base 10, de 25 Hz a 16 kHz).
+ */
+float espectro_frequencia_terco(uint banda) {
+    return 1000.f * powf(10.f, ((int)banda - 16) / 10.f);
+}
+
+/**
+ * Frequência central da banda de oitava (base 10, de 31,5 Hz a 16 kHz).
+ */
+float espectro_frequencia_oitava(uint banda) {
+    return 1000.f * powf(10.f, (3 * (int)banda - 15) / 10.f);
+}
+
+/**
+ * Calcula quais bins (e com que peso nas bordas) formam a banda [f_ini, f_fim).
+ * Cada bin k cobre [k - 1/2, k + 1/2] * resolução.
+ */
+static void banda_preparar(banda_t *banda, float f_ini, float f_fim, uint32_t taxa_amostragem) {
+    const float resolucao = (float)taxa_amostragem / ESPECTRO_N;
+    float b_ini = f_ini / resolucao;
+    float b_fim = f_fim / resolucao;
+
+    if (b_fim > ESPECTRO_N / 2 - 0.5f)
+        b_fim = ESPECTRO_N / 2 - 0.5f;  // Para em Nyquist
+    if (b_ini < 0.5f)
+        b_ini = 0.5f;                   // Ignora o bin DC
+    if (b_ini >= b_fim) {
+        banda->k_ini = 1;
+        banda->k_fim = 0;               // Banda vazia
+        return;
+    }
+
+    banda->k_ini = (uint16_t)floorf(b_ini + 0.5f);
+    banda->k_fim = (uint16_t)floorf(b_fim + 0.5f);
+    if (banda->k_fim >= ESPECTRO_N / 2)
+        banda->k_fim = ESPECTRO_N / 2 - 1;
+
+    if (banda->k_ini == banda->k_fim) {
+        // Banda mais estreita que um bin: recebe só a fração sobreposta
+        banda->peso_ini = banda->peso_fim = (uint16_t)fminf((b_fim - b_ini) * 65536.f, 65535.f);
+    } else {
+        banda->peso_ini = (uint16_t)fminf((banda->k_ini + 0.5f - b_ini) * 65536.f, 65535.f);
+        banda->peso_fim = (uint16_t)fminf((b_fim - (banda->k_fim - 0.5f)) * 65536.f, 65535.f);
+    }
+}
+
+/**
+ * Inicializa o analisador para a taxa de amostragem efetiva.
+ * As tabelas usam ponto flutuante, mas só aqui.
+ */
+void espectro_init(espectro_t *esp, uint32_t taxa_amostragem) {
+    if (!tabelas_prontas) {
+        for (uint i = 0; i < count_of(seno_q15); ++i)
+            seno_q15[i] = (int16_t)lroundf(32767.f * sinf(2.f * (float)M_PI * i / ESPECTRO_N));
+        for (uint i = 0; i < ESPECTRO_N; ++i)
+            janela_q15[i] = (int16_t)lroundf(32767.f * 0.5f * (1.f - cosf(2.f * (float)M_PI * i / ESPECTRO_N)));
+        tabelas_prontas = true;
+    }
+
+    // Bordas das bandas: fc * 10^(+-1/20) para 1/3 de oitava e fc * 10^(+-3/20) para oitava
+    for (uint b = 0; b < ESPECTRO_BANDAS_TERCO; ++b) {
+        float fc = espectro_frequencia_terco(b);
+        banda_preparar(&esp->terco[b], fc * powf(10.f, -0.05f), fc * powf(10.f, 0.05f), taxa_amostragem);
+    }
+    for (uint b = 0; b < ESPECTRO_BANDAS_OITAVA; ++b) {
+        float fc = espectro_frequencia_oitava(b);
+        banda_preparar(&esp->oitava[b], fc * powf(10.f, -0.15f), fc * powf(10.f, 0.15f), taxa_amostragem);
+    }
+
+    espectro_reiniciar(esp);
+}
+
+/**
+ * Descarta o quadro em andamento e as energias acumuladas.
+ */
+void espectro_reiniciar(espectro_t *esp) {
+    esp->preenchidas = 0;
+    esp->quadros = 0;
+    esp->expoente = 0;
+    memset(esp->potencia, 0, sizeof(esp->potencia));
+    memset(esp->energia_terco, 0, sizeof(esp->energia_terco));
+    memset(esp->energia_oitava, 0, sizeof(esp->energia_oitava));
+}
+
+/**
+ * Multiplicação complexa em Q15 com arredondamento.
+ */
+static inline void mult_q15(int32_t re, int32_t im, int32_t wr, int32_t wi, int16_t *saida) {
+    saida[0] = (int16_t)((re * wr - im * wi + (1 << 14)) >> 15);
+    saida[1] = (int16_t)((re * wi + im * wr + (1 << 14)) >> 15);
+}
+
+/**
+ * Maior magnitude entre os componentes do vetor.
+ */
+static int32_t fft_maximo(const int16_t *dados) {
+    int32_t maximo = 0;
+    for (uint32_t i = 0; i < 2 * ESPECTRO_N; ++i) {
+        int32_t v = dados[i] < 0 ? -dados[i] : dados[i];
+        if (v > maximo)
+            maximo = v;
+    }
+    return maximo;
+}
+
+/**
+ * FFT radix-4 com decimação em frequência, no lugar, em Q15 com ponto
+ * flutuante em blocos: a entrada é normalizada para ocupar a faixa útil
+ * (sinais fracos não se perdem no arredondamento) e cada estágio só divide
+ * por 4 (ou 8) se algum componente passar de FFT_LIMITE_SEM_ESCALA. A saída sai
+ * em ordem natural. Retorna o expoente aplicado (X = saída * 2^retorno).
+ */
+int32_t fft_radix4_q15(int16_t *dados) {
+    int32_t expoente = 0;
+
+    // Normalização inicial (expoente negativo)
+    int32_t maximo = fft_maximo(dados);
+    if (maximo > 0) {
+        uint32_t desloca = 0;
+        while ((maximo << (desloca + 1)) <= FFT_LIMITE_SEM_ESCALA)
+            desloca++;
+        if (desloca) {
+            for (uint32_t i = 0; i < 2 * ESPECTRO_N; ++i)
+                dados[i] = (int16_t)(dados[i] << desloca);
+            expoente = -(int32_t)desloca;
+        }
+    }
+
+    for (uint32_t l = ESPECTRO_N; l >= 4; l >>= 2) {
+        const uint32_t q = l >> 2;
+        const uint32_t passo = ESPECTRO_N / l;  // Passo na tabela de senos
+
+        // Ponto flutuante em blocos: mede a maior magnitude antes do estágio
+        maximo = fft_maximo(dados);
+        const uint32_t escala = maximo > FFT_LIMITE_ESCALA_4 ? 3 : maximo > FFT_LIMITE_SEM_ESCALA ? 2 : 0;
+        const int32_t arredonda = escala ? 1 << (escala - 1) : 0;
+        expoente += escala;
+
+        for (uint32_t j = 0; j < q; ++j) {
+            // Fatores de giro W^j, W^2j, W^3j (sentido direto: e^-i)
+            const int32_t w1r = seno_q15[j * passo + ESPECTRO_N / 4], w1i = -seno_q15[j * passo];
+            const int32_t w2r = seno_q15[2 * j * passo + ESPECTRO_N / 4], w2i = -seno_q15[2 * j * passo];
+            const int32_t w3r = seno_q15[3 * j * passo + ESPECTRO_N / 4], w3i = -seno_q15[3 * j * passo];
+
+            for (uint32_t g = j; g < ESPECTRO_N; g += l) {
+                int16_t *a = &dados[2 * g];
+                int16_t *b = &dados[2 * (g + q)];
+                int16_t *c = &dados[2 * (g + 2 * q)];
+                int16_t *d = &dados[2 * (g + 3 * q)];
+
+                int32_t t0r = a[0] + c[0], t0i = a[1] + c[1];
+                int32_t t1r = a[0] - c[0], t1i = a[1] - c[1];
+                int32_t t2r = b[0] + d[0], t2i = b[1] + d[1];
+                int32_t t3r = b[0] - d[0], t3i = b[1] - d[1];
+
+                // Saídas antes dos fatores de giro, já escaladas
+                int32_t y0r = (t0r + t2r + arredonda) >> escala, y0i = (t0i + t2i + arredonda) >> escala;
+                int32_t y2r = (t0r - t2r + arredonda) >> escala, y2i = (t0i - t2i + arredonda) >> escala;
+                int32_t y1r = (t1r + t3i + arredonda) >> escala, y1i = (t1i - t3r + arredonda) >> escala;  // t1 - i*t3
+                int32_t y3r = (t1r - t3i + arredonda) >> escala, y3i = (t1i + t3r + arredonda) >> escala;  // t1 + i*t3
+
+                a[0] = (int16_t)y0r;
+                a[1] = (int16_t)y0i;
+                mult_q15(y1r, y1i, w1r, w1i, b);  // Saída em ordem de dígitos invertidos (corrigida no fim)
+                mult_q15(y2r, y2i, w2r, w2i, c);
+                mult_q15(y3r, y3i, w3r, w3i, d);
+            }
+        }
+    }
+
+    // Reordena a saída (inversão de dígitos de base 4 -> ordem natural)
+    for (uint32_t i = 0; i < ESPECTRO_N; ++i) {
+        uint32_t r = 0, v = i;
+        for (uint32_t s = 0; s < ESPECTRO_LOG4N; ++s) {
+            r = (r << 2) | (v & 3);
+            v >>= 2;
+        }
+        if (r > i) {
+            int16_t tr = dados[2 * i], ti = dados[2 * i + 1];
+            dados[2 * i] = dados[2 * r];
+            dados[2 * i + 1] = dados[2 * r + 1];
+            dados[2 * r] = tr;
+            dados[2 * r + 1] = ti;
+        }
+    }
+    return expoente;
+}
+
+/**
+ * Soma a potência dos bins de uma banda, com os pesos das bordas.
+ */
+static uint64_t banda_potencia(const banda_t *banda, const uint32_t *potencia) {
+    if (banda->k_fim < banda->k_ini)
+        return 0;
+    if (banda->k_ini == banda->k_fim)
+        return ((uint64_t)potencia[banda->k_ini] * banda->peso_ini) >> 16;
+
+    uint64_t soma = ((uint64_t)potencia[banda->k_ini] * banda->peso_ini) >> 16;
+    for (uint k = banda->k_ini + 1; k < banda->k_fim; ++k)
+        soma += potencia[k];
+    soma += ((uint64_t)potencia[banda->k_fim] * banda->peso_fim) >> 16;
+    return soma;
+}
+
+/**
+ * Converte a potência de um quadro para a escala comum dos acumuladores:
+ * |X|^2 * 2^(2 * expoente) / N^2, com 8 bits fracionários.
+ */
+static uint64_t banda_normalizar(uint64_t soma, int32_t expoente) {
+    int32_t desloca = 2 * expoente + 8 - 4 * ESPECTRO_LOG4N;
+    return desloca >= 0 ? soma << desloca : soma >> -desloca;
+}
+
+/**
+ * Processa um quadro completo: FFT, espectro de potência e energia por banda.
+ */
+static void espectro_quadro(espectro_t *esp) {
+    esp->expoente = fft_radix4_q15(esp->dados);
+
+    for (uint k = 0; k < ESPECTRO_N / 2; ++k) {
+        int32_t re = esp->dados[2 * k], im = esp->dados[2 * k + 1];
+        esp->potencia[k] = (uint32_t)(re * re) + (uint32_t)(im * im);
+    }
+
+    for (uint b = 0; b < ESPECTRO_BANDAS_TERCO; ++b)
+        esp->energia_terco[b] += banda_normalizar(banda_potencia(&esp->terco[b], esp->potencia), esp->expoente);
+    for (uint b = 0; b < ESPECTRO_BANDAS_OITAVA; ++b)
+        esp->energia_oitava[b] += banda_normalizar(banda_potencia(&esp->oitava[b], esp->potencia), esp->expoente);
+
+    esp->quadros++;
+}
+
+/**
+ * Adiciona amostras (formato interno) ao quadro em andamento, aplicando a
+ * janela de Hann. Cada vez que ESPECTRO_N amostras se completam, calcula a
+ * FFT e acumula as bandas. Retorna quantos quadros foram completados.
+ */
+uint espectro_adicionar(espectro_t *esp, const int32_t *amostras, uint n) {
+    uint completos = 0;
+
+    for (uint i = 0; i < n; ++i) {
+        int32_t x = amostras[i];
+        if (x > INT16_MAX)
+            x = INT16_MAX;
+        else if (x < INT16_MIN)
+            x = INT16_MIN;
+
+        uint32_t p = esp->preenchidas;
+        esp->dados[2 * p] = (int16_t)((x * janela_q15[p] + (1 << 14)) >> 15);
+        esp->dados[2 * p + 1] = 0;
+
+        if (++esp->preenchidas == ESPECTRO_N) {
+            espectro_quadro(esp);
+            esp->preenchidas = 0;
+            completos++;
+        }
+    }
+    return completos;
+}
+
+/**
+ * Entrega a média quadrática (unidades internas^2) de cada banda desde a
+ * última chamada e zera os acumuladores. Os ponteiros podem ser NULL.
+ * Correção da janela de Hann (potência média 3/8) e do espectro de um lado
+ * (x2): média quadrática = soma |X|^2 * 16 / (3 * N^2).
+ * Retorna o número de quadros que formam a média (0 = nenhum dado).
+ */
+uint32_t espectro_bandas(espectro_t *esp, uint64_t *terco, uint64_t *oitava) {
+    uint32_t quadros = esp->quadros;
+    const uint64_t divisor = 3ull * (quadros ? quadros : 1) << 8;
+
+    for (uint b = 0; b < ESPECTRO_BANDAS_TERCO; ++b) {
+        if (terco)
+            terco[b] = esp->energia_terco[b] * 16 / divisor;
+        esp->energia_terco[b] = 0;
+    }
+    for (uint b = 0; b < ESPECTRO_BANDAS_OITAVA; ++b) {
+        if (oitava)
+            oitava[b] = esp->energia_oitava[b] * 16 / divisor;
+        esp->energia_oitava[b] = 0;
+    }
+
+    esp->quadros = 0;
+    return quadros;
+}
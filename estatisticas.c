@@ -0,0 +1,143 @@
+#include "lib/estatisticas.h"  // Motor de estatísticas de nível (Leq, Lmax, Lmin, Ln)
+#include <string.h>  // memset
+
+// Subjanelas que completam cada janela (a de 1 min é completada por blocos)
+static const uint32_t subjanelas_por_janela[EST_JANELAS] = {1, 15, 4};
+
+/**
+ * Zera o acumulador de uma janela.
+ */
+static void acumulador_zerar(est_acumulador_t *acc) {
+    memset(acc->histograma, 0, sizeof(acc->histograma));
+    acc->soma_quadratica = 0;
+    acc->blocos = 0;
+    acc->subjanelas = 0;
+    acc->min_ddb = INT16_MAX;
+    acc->max_ddb = INT16_MIN;
+}
+
+/**
+ * Soma o conteúdo de um acumulador em outro. O(EST_BINS).
+ */
+static void acumulador_somar(est_acumulador_t *destino, const est_acumulador_t *origem) {
+    for (uint i = 0; i < EST_BINS; ++i)
+        destino->histograma[i] += origem->histograma[i];
+    destino->soma_quadratica += origem->soma_quadratica;
+    destino->blocos += origem->blocos;
+    if (origem->min_ddb < destino->min_ddb)
+        destino->min_ddb = origem->min_ddb;
+    if (origem->max_ddb > destino->max_ddb)
+        destino->max_ddb = origem->max_ddb;
+}
+
+/**
+ * Nível (0,1 dB) excedido em uma fração do tempo, percorrendo o histograma
+ * de cima para baixo. O(EST_BINS).
+ */
+static int16_t acumulador_percentil(const est_acumulador_t *acc, uint32_t excedido_pct) {
+    uint32_t limite = (uint32_t)((uint64_t)acc->blocos * excedido_pct / 100);
+    uint32_t contagem = 0;
+
+    for (int i = EST_BINS - 1; i >= 0; --i) {
+        contagem += acc->histograma[i];
+        if (contagem > limite)
+            return (int16_t)(EST_DB_MIN * 10 + i);
+    }
+    return EST_DB_MIN * 10;
+}
+
+/**
+ * Calcula o resultado de um acumulador. O(EST_BINS).
+ */
+static void acumulador_resultado(const estatisticas_t *est, const est_acumulador_t *acc, est_resultado_t *resultado) {
+    resultado->blocos = acc->blocos;
+    if (acc->blocos == 0) {
+        resultado->leq = resultado->lmin = resultado->lmax = 0;
+        resultado->l10 = resultado->l50 = resultado->l90 = 0;
+        return;
+    }
+    resultado->leq = est->para_ddb(acc->soma_quadratica / acc->blocos);
+    resultado->lmin = acc->min_ddb;
+    resultado->lmax = acc->max_ddb;
+    resultado->l10 = acumulador_percentil(acc, 10);
+    resultado->l50 = acumulador_percentil(acc, 50);
+    resultado->l90 = acumulador_percentil(acc, 90);
+}
+
+/**
+ * Inicializa o motor. blocos_por_minuto define quando a janela de 1 min fecha.
+ */
+void estatisticas_init(estatisticas_t *est, uint32_t blocos_por_minuto, est_para_ddb_t para_ddb) {
+    est->blocos_por_minuto = blocos_por_minuto;
+    est->para_ddb = para_ddb;
+    estatisticas_reiniciar(est);
+}
+
+/**
+ * Descarta todas as janelas (por exemplo, ao trocar a ponderação).
+ */
+void estatisticas_reiniciar(estatisticas_t *est) {
+    for (uint j = 0; j < EST_JANELAS; ++j) {
+        acumulador_zerar(&est->acumulador[j]);
+        memset(&est->ultima[j], 0, sizeof(est->ultima[j]));
+    }
+}
+
+/**
+ * Adiciona um bloco de medição: a média quadrática do bloco (para o Leq) e
+ * o seu nível com ponderação temporal (para Lmin/Lmax/Ln). O(1) por bloco;
+ * ao fechar uma janela, o resultado é calculado e o histograma é somado na
+ * janela seguinte, em O(EST_BINS).
+ */
+void estatisticas_adicionar(estatisticas_t *est, uint64_t media_quadratica, int16_t nivel_ddb) {
+    est_acumulador_t *acc = &est->acumulador[EST_JANELA_1MIN];
+
+    int bin = nivel_ddb - EST_DB_MIN * 10;
+    if (bin < 0)
+        bin = 0;
+    else if (bin >= EST_BINS)
+        bin = EST_BINS - 1;
+
+    acc->histograma[bin]++;
+    acc->soma_quadratica += media_quadratica;
+    acc->blocos++;
+    if (nivel_ddb < acc->min_ddb)
+        acc->min_ddb = nivel_ddb;
+    if (nivel_ddb > acc->max_ddb)
+        acc->max_ddb = nivel_ddb;
+
+    if (acc->blocos < est->blocos_por_minuto)
+        return;
+    acc->subjanelas = 1;
+
+    // Fecha as janelas completas em cascata
+    for (uint j = 0; j < EST_JANELAS; ++j) {
+        acc = &est->acumulador[j];
+        if (acc->subjanelas < subjanelas_por_janela[j])
+            break;
+
+        acumulador_resultado(est, acc, &est->ultima[j]);
+        est->ultima[j].numero++;
+
+        if (j + 1 < EST_JANELAS) {
+            acumulador_somar(&est->acumulador[j + 1], acc);
+            est->acumulador[j + 1].subjanelas++;
+        }
+        acumulador_zerar(acc);
+    }
+}
+
+/**
+ * Resultado da janela em andamento, incluindo as subjanelas ainda abertas
+ * das janelas menores. O(EST_BINS * EST_JANELAS).
+ */
+void estatisticas_parcial(const estatisticas_t *est, est_janela_t janela, est_resultado_t *resultado) {
+    static est_acumulador_t soma;  // Grande demais para a pilha; só o núcleo 1 consulta
+
+    acumulador_zerar(&soma);
+    for (uint j = 0; j <= (uint)janela; ++j)
+        acumulador_somar(&soma, &est->acumulador[j]);
+
+    acumulador_resultado(est, &soma, resultado);
+    resultado->numero = est->ultima[janela].numero;
+}
@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""Extrai as gravações de eventos do log serial do SoundMonitor para WAV.
+
+Uso: python3 gravacao.py log_serial.txt [pasta_saida]
+     (ou o log pela entrada padrão: ... | python3 gravacao.py -)
+
+Cada bloco [GRAVACAO] Inicio ... Fim vira gravacao_<n>.wav (16 bits, mono),
+com as linhas [PCM] (int16 big-endian em hexadecimal) ou [ADPCM] (um bloco
+IMA-ADPCM por linha, no formato de adpcm.c).
+"""
+import os
+import re
+import struct
+import sys
+import wave
+
+PASSOS = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767]
+AJUSTE_INDICE = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+INICIO = re.compile(r"\[GRAVACAO\] Inicio #(\d+): .*?, (\d+) Hz, ([\w-]+),")
+FIM = re.compile(r"\[GRAVACAO\] Fim #(\d+)")
+
+
+def adpcm_decodificar_bloco(bloco):
+    """Decodifica um bloco: cabeçalho (preditor, índice, livre) + nibbles."""
+    predito, indice = struct.unpack_from("<hB", bloco)
+    indice = min(indice, 88)
+    amostras = []
+    for byte in bloco[4:]:
+        for codigo in (byte & 0xF, byte >> 4):
+            passo = PASSOS[indice]
+            delta = passo >> 3
+            if codigo & 4:
+                delta += passo
+            if codigo & 2:
+                delta += passo >> 1
+            if codigo & 1:
+                delta += passo >> 2
+            predito = predito - delta if codigo & 8 else predito + delta
+            predito = max(-32768, min(32767, predito))
+            indice = max(0, min(88, indice + AJUSTE_INDICE[codigo & 7]))
+            amostras.append(predito)
+    return amostras
+
+
+def salvar_wav(caminho, taxa, amostras):
+    with wave.open(caminho, "wb") as wav:
+        wav.setnchannels(1)
+        wav.setsampwidth(2)
+        wav.setframerate(taxa)
+        wav.writeframes(struct.pack("<%dh" % len(amostras), *amostras))
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 1
+    entrada = sys.stdin if sys.argv[1] == "-" else open(sys.argv[1], errors="replace")
+    pasta = sys.argv[2] if len(sys.argv) > 2 else "."
+
+    atual = None  # (número, taxa, formato, amostras)
+    for linha in entrada:
+        m = INICIO.search(linha)
+        if m:
+            atual = (int(m.group(1)), int(m.group(2)), m.group(3), [])
+            continue
+        if atual is None:
+            continue
+
+        numero, taxa, formato, amostras = atual
+        if "[PCM] " in linha:
+            dados = bytes.fromhex(linha.split("[PCM] ", 1)[1].strip())
+            amostras.extend(struct.unpack(">%dh" % (len(dados) // 2), dados))
+        elif "[ADPCM] " in linha:
+            amostras.extend(adpcm_decodificar_bloco(bytes.fromhex(linha.split("[ADPCM] ", 1)[1].strip())))
+        elif FIM.search(linha):
+            caminho = os.path.join(pasta, "gravacao_%d.wav" % numero)
+            salvar_wav(caminho, taxa, amostras)
+            print("%s: %d amostras a %d Hz (%s)" % (caminho, len(amostras), taxa, formato))
+            atual = None
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Decodifica as linhas [R] do registro binário do SoundMonitor.
+
+Uso: python3 registro.py log_serial.txt [-t]
+     (ou o log pela entrada padrão: ... | python3 registro.py -)
+
+As linhas "[R] <hex>" viram o texto do formato correspondente em
+lib/registro_formatos.h; as demais linhas passam sem mudança. Com -t, cada
+registro decodificado recebe o instante em que foi gravado (s desde o boot).
+"""
+import os
+import re
+import struct
+import sys
+
+FORMATOS_H = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "lib", "registro_formatos.h")
+
+ENTRADA = re.compile(r'X\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+CONVERSAO = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|j|t)?([diuxXcfeEgGs%])")
+ESCAPES = {"n": "\n", "t": "\t", '"': '"', "\\": "\\"}
+
+
+def carregar_formatos(caminho):
+    """Lista de formatos na ordem do X-macro (a posição é o número do formato)."""
+    with open(caminho, encoding="utf-8") as arquivo:
+        texto = arquivo.read()
+    texto = texto[texto.index("#define REGISTRO_FORMATOS(X)"):]  # Pula o exemplo do comentário
+    return [re.sub(r"\\(.)", lambda m: ESCAPES.get(m.group(1), m.group(1)), m.group(2))
+            for m in ENTRADA.finditer(texto)]
+
+
+def decodificar(dados, formatos):
+    """Retorna (tempo_us, texto) de um registro."""
+    tempo_us, numero = struct.unpack_from("<IH", dados)
+    if numero >= len(formatos):
+        return tempo_us, "[R] formato desconhecido %d: %s" % (numero, dados[6:].hex())
+    posicao = 6
+
+    def converter(m):
+        nonlocal posicao
+        opcoes, tipo = m.groups()
+        if tipo == "%":
+            return "%"
+        if posicao >= len(dados):
+            return "?"
+        if tipo == "s":
+            tamanho = dados[posicao]
+            valor = dados[posicao + 1:posicao + 1 + tamanho].decode("utf-8", "replace")
+            posicao += 1 + tamanho
+        else:
+            palavra = dados[posicao:posicao + 4]
+            posicao += 4
+            if tipo in "feEgG":
+                valor = struct.unpack("<f", palavra)[0]
+            elif tipo in "di":
+                valor = struct.unpack("<i", palavra)[0]
+            elif tipo == "c":
+                valor = chr(palavra[0])
+            else:
+                valor = struct.unpack("<I", palavra)[0]
+                tipo = "d" if tipo == "u" else tipo
+        return ("%" + opcoes + tipo) % valor
+
+    return tempo_us, CONVERSAO.sub(converter, formatos[numero])
+
+
+def main():
+    argumentos = [a for a in sys.argv[1:] if a != "-t"]
+    if not argumentos:
+        print(__doc__)
+        return 1
+    com_tempo = "-t" in sys.argv[1:]
+    formatos = carregar_formatos(FORMATOS_H)
+    entrada = sys.stdin if argumentos[0] == "-" else open(argumentos[0], errors="replace")
+
+    for linha in entrada:
+        inicio = linha.find("[R] ")
+        if inicio < 0:
+            sys.stdout.write(linha)
+            continue
+        try:
+            tempo_us, texto = decodificar(bytes.fromhex(linha[inicio + 4:].strip()), formatos)
+        except (ValueError, struct.error):
+            sys.stdout.write(linha)  # Linha cortada ou misturada com outra saída
+            continue
+        if com_tempo:
+            texto = "%10.6f %s" % (tempo_us / 1e6, texto)
+        print(texto)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,95 @@
+#include "lib/fila_spsc.h"  // Fila SPSC entre os núcleos
+#include "hardware/sync.h"  // Barreiras de memória (__dmb)
+#include <string.h>  // memcpy
+
+/**
+ * Inicializa a fila sobre um armazenamento fornecido pelo chamador.
+ * O armazenamento deve ter capacidade * tamanho_item bytes.
+ */
+void fila_spsc_init(fila_spsc_t *fila, void *armazenamento, uint32_t tamanho_item, uint32_t capacidade) {
+    hard_assert((capacidade & (capacidade - 1)) == 0);  // Capacidade precisa ser potência de 2
+
+    fila->dados = (uint8_t *)armazenamento;
+    fila->tamanho_item = tamanho_item;
+    fila->mascara = capacidade - 1;
+    fila->cabeca = 0;
+    fila->cauda = 0;
+    fila->descartados = 0;
+    fila->profundidade_max = 0;
+}
+
+/**
+ * Insere um item (lado do produtor). Retorna false e conta um descarte
+ * se a fila estiver cheia; nunca bloqueia.
+ */
+bool fila_spsc_push(fila_spsc_t *fila, const void *item) {
+    uint32_t cabeca = fila->cabeca;
+    uint32_t ocupacao = cabeca - fila->cauda;
+
+    if (ocupacao > fila->mascara) {
+        fila->descartados++;
+        return false;
+    }
+
+    memcpy(fila->dados + (cabeca & fila->mascara) * fila->tamanho_item, item, fila->tamanho_item);
+
+    __dmb();  // O item precisa estar visível ao outro núcleo antes da nova cabeça
+    fila->cabeca = cabeca + 1;
+
+    if (ocupacao + 1 > fila->profundidade_max)
+        fila->profundidade_max = ocupacao + 1;
+    return true;
+}
+
+/**
+ * Reserva a próxima posição para o produtor escrever o item no lugar, sem
+ * cópia. Retorna NULL e conta um descarte se a fila estiver cheia. O item
+ * só fica visível ao consumidor em fila_spsc_publicar().
+ */
+void *fila_spsc_reservar(fila_spsc_t *fila) {
+    uint32_t cabeca = fila->cabeca;
+    if (cabeca - fila->cauda > fila->mascara) {
+        fila->descartados++;
+        return NULL;
+    }
+    return fila->dados + (cabeca & fila->mascara) * fila->tamanho_item;
+}
+
+/**
+ * Publica o item escrito na posição de fila_spsc_reservar().
+ */
+void fila_spsc_publicar(fila_spsc_t *fila) {
+    uint32_t cabeca = fila->cabeca;
+    uint32_t ocupacao = cabeca - fila->cauda;
+
+    __dmb();  // O item precisa estar visível ao outro núcleo antes da nova cabeça
+    fila->cabeca = cabeca + 1;
+
+    if (ocupacao + 1 > fila->profundidade_max)
+        fila->profundidade_max = ocupacao + 1;
+}
+
+/**
+ * Retira o item mais antigo (lado do consumidor). Retorna false se a fila
+ * estiver vazia; nunca bloqueia.
+ */
+bool fila_spsc_pop(fila_spsc_t *fila, void *item) {
+    uint32_t cauda = fila->cauda;
+
+    if (cauda == fila->cabeca)
+        return false;
+
+    __dmb();  // Lê o item só depois de observar a cabeça que o publicou
+    memcpy(item, fila->dados + (cauda & fila->mascara) * fila->tamanho_item, fila->tamanho_item);
+
+    __dmb();  // Termina a cópia antes de liberar a posição para o produtor
+    fila->cauda = cauda + 1;
+    return true;
+}
+
+/**
+ * Retorna o número de itens atualmente na fila.
+ */
+uint32_t fila_spsc_profundidade(const fila_spsc_t *fila) {
+    return fila->cabeca - fila->cauda;
+}
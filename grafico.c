@@ -0,0 +1,159 @@
+#include "lib/grafico.h"  // Primitivas inteiras e gráficos no display
+
+/**
+ * Acende um pixel, ignorando os que caem fora da tela.
+ */
+static inline void acender(ssd1306_t *p, int x, int y) {
+    if ((uint32_t)x < p->width && (uint32_t)y < p->height)
+        p->buffer[(y >> 3) * p->width + x] |= 1u << (y & 7);
+}
+
+/**
+ * Linha de (x0, y0) a (x1, y1), pontas inclusas (Bresenham, só inteiros).
+ */
+void grafico_linha(ssd1306_t *p, int x0, int y0, int x1, int y1) {
+    int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    int dy = y1 > y0 ? y0 - y1 : y1 - y0;  // Negativo
+    int passo_x = x0 < x1 ? 1 : -1;
+    int passo_y = y0 < y1 ? 1 : -1;
+    int erro = dx + dy;
+    for (;;) {
+        acender(p, x0, y0);
+        if (x0 == x1 && y0 == y1)
+            break;
+        int e2 = 2 * erro;
+        if (e2 >= dy) {
+            erro += dy;
+            x0 += passo_x;
+        }
+        if (e2 <= dx) {
+            erro += dx;
+            y0 += passo_y;
+        }
+    }
+}
+
+/**
+ * Acende (ou apaga) o retângulo cheio: em cada página uma máscara com as
+ * linhas cobertas, aplicada de uma vez a cada coluna.
+ */
+void grafico_preencher(ssd1306_t *p, int x, int y, int largura, int altura, bool aceso) {
+    int x0 = x < 0 ? 0 : x, x1 = x + largura > (int)p->width ? (int)p->width : x + largura;
+    int y0 = y < 0 ? 0 : y, y1 = y + altura > (int)p->height ? (int)p->height : y + altura;
+    if (x0 >= x1 || y0 >= y1)
+        return;
+    for (int pagina = y0 >> 3; pagina <= (y1 - 1) >> 3; ++pagina) {
+        uint8_t mascara = 0xFF;
+        if (pagina == y0 >> 3)
+            mascara &= 0xFF << (y0 & 7);
+        if (pagina == (y1 - 1) >> 3)
+            mascara &= 0xFF >> (7 - ((y1 - 1) & 7));
+        uint8_t *byte = p->buffer + pagina * p->width + x0;
+        for (int c = x0; c < x1; ++c, ++byte) {
+            if (aceso)
+                *byte |= mascara;
+            else
+                *byte &= ~mascara;
+        }
+    }
+}
+
+/**
+ * Linha horizontal de x0 a x1 (inclusos) na linha y.
+ */
+void grafico_linha_h(ssd1306_t *p, int x0, int x1, int y) {
+    if (x0 > x1) {
+        int t = x0;
+        x0 = x1;
+        x1 = t;
+    }
+    grafico_preencher(p, x0, y, x1 - x0 + 1, 1, true);
+}
+
+/**
+ * Linha vertical de y0 a y1 (inclusos) na coluna x.
+ */
+void grafico_linha_v(ssd1306_t *p, int x, int y0, int y1) {
+    if (y0 > y1) {
+        int t = y0;
+        y0 = y1;
+        y1 = t;
+    }
+    grafico_preencher(p, x, y0, 1, y1 - y0 + 1, true);
+}
+
+/**
+ * Contorno de (x, y) a (x + largura, y + altura), como ssd1306_draw_empty_square().
+ */
+void grafico_contorno(ssd1306_t *p, int x, int y, int largura, int altura) {
+    grafico_linha_h(p, x, x + largura, y);
+    grafico_linha_h(p, x, x + largura, y + altura);
+    grafico_linha_v(p, x, y, y + altura);
+    grafico_linha_v(p, x + largura, y, y + altura);
+}
+
+/**
+ * Barra horizontal: contorno na área dada e o interior aceso da esquerda
+ * até a fração de valor na faixa minimo..maximo (o resto é apagado).
+ */
+void grafico_barra(ssd1306_t *p, int x, int y, int largura, int altura, float valor, float minimo, float maximo) {
+    grafico_contorno(p, x, y, largura - 1, altura - 1);
+    int interno = largura - 2;
+    float fracao = (valor - minimo) / (maximo - minimo);
+    int cheio = fracao <= 0.f ? 0 : fracao >= 1.f ? interno : (int)(fracao * interno + 0.5f);
+    grafico_preencher(p, x + 1, y + 1, cheio, altura - 2, true);
+    grafico_preencher(p, x + 1 + cheio, y + 1, interno - cheio, altura - 2, false);
+}
+
+/**
+ * Prepara um histórico vazio na área dada (largura até GRAFICO_HISTORICO_MAX).
+ */
+void grafico_historico_init(grafico_historico_t *h, int x, int y, int largura, int altura, float minimo, float maximo) {
+    h->x = x;
+    h->y = y;
+    h->largura = largura < GRAFICO_HISTORICO_MAX ? largura : GRAFICO_HISTORICO_MAX;
+    h->altura = altura;
+    h->minimo = minimo;
+    h->maximo = maximo;
+    h->total = 0;
+    h->desenhados = 0;
+}
+
+/**
+ * Guarda um ponto novo na coluna do cursor (convertido em altura na área).
+ */
+void grafico_historico_adicionar(grafico_historico_t *h, float valor) {
+    float fracao = (valor - h->minimo) / (h->maximo - h->minimo);
+    int pixels = fracao <= 0.f ? 0 : fracao >= 1.f ? h->altura : (int)(fracao * h->altura + 0.5f);
+    h->pontos[h->total % h->largura] = (uint8_t)pixels;
+    h->total++;
+}
+
+/**
+ * Desenha uma coluna da área: apagada, com a área preenchida de baixo até
+ * a altura do ponto.
+ */
+static void desenhar_coluna(ssd1306_t *p, const grafico_historico_t *h, int coluna, int pixels) {
+    int x = h->x + coluna;
+    grafico_preencher(p, x, h->y, 1, h->altura - pixels, false);
+    grafico_preencher(p, x, h->y + h->altura - pixels, 1, pixels, true);
+}
+
+/**
+ * Leva ao quadro os pontos adicionados desde o último desenho. Com completo
+ * (quadro limpo ou com outra tela) redesenha a área inteira.
+ */
+void grafico_historico_desenhar(ssd1306_t *p, grafico_historico_t *h, bool completo) {
+    if (completo || h->total - h->desenhados >= (uint32_t)h->largura) {
+        grafico_preencher(p, h->x, h->y, h->largura, h->altura, false);
+        h->desenhados = h->total > (uint32_t)h->largura ? h->total - h->largura : 0;
+    }
+    if (h->total == h->desenhados && !completo)
+        return;
+    for (; h->desenhados < h->total; ++h->desenhados)
+        desenhar_coluna(p, h, h->desenhados % h->largura, h->pontos[h->desenhados % h->largura]);
+
+    // Lacuna e cursor: a coluna seguinte ao ponto mais novo fica apagada
+    if (h->total > 0 && h->largura > 1)
+        desenhar_coluna(p, h, h->total % h->largura, 0);
+}
@@ -0,0 +1,236 @@
+#include "lib/gravador.h"    // Gravação do áudio em volta de um evento
+#include "hardware/sync.h"   // Barreiras de memória (__dmb)
+#include <stdio.h>
+
+#define GRAVADOR_AMOSTRAS_LINHA 32  // Amostras por linha exportada em PCM (divide SAMPLES em todas as taxas)
+#define GRAVADOR_EXPORTAR_BLOCOS (GRAVADOR_EXPORTAR_BYTES / GRAVADOR_BYTES_BLOCO + 1)
+
+// Anel de blocos inteiros. Em PCM o bloco do DMA em andamento é decimado
+// direto para cá, sem cópia intermediária; em ADPCM ele passa pela entrada
+// e é codificado ao ser concluído
+static uint8_t anel[GRAVADOR_BLOCOS][GRAVADOR_BYTES_BLOCO] __attribute__((aligned(4)));
+#if GRAVADOR_ADPCM
+static int16_t entrada[SAMPLES];
+static adpcm_estado_t codificador;
+#endif
+
+// Estado do anel (núcleo 1)
+static uint32_t proximo;         // Próximo bloco do anel a gravar
+static uint32_t gravados;        // Blocos válidos no anel (até GRAVADOR_BLOCOS)
+static uint32_t pos_restantes;   // Blocos que faltam para completar a janela pós-gatilho
+static uint32_t gatilhos_acima;  // Condições ativas no bloco anterior (o disparo é na subida)
+static bool bloco_pendente;      // gravador_proximo_bloco() entregou um bloco ainda não concluído
+static volatile gravador_estado_t estado = GRAVADOR_GRAVANDO;
+
+// Janela congelada: escrita pelo núcleo 1 antes de publicar GRAVADOR_CONGELADO
+static gravacao_info_t gravacao;
+static uint32_t primeiro_congelado;  // Bloco mais antigo da janela no anel
+
+// Configuração e liberação pedidas pelo núcleo 0
+static volatile uint32_t gatilhos_solicitados = GRAVADOR_GATILHOS_PADRAO;
+static volatile int16_t limiar_nivel_ddb = GRAVADOR_NIVEL_PADRAO_DDB;
+static volatile int16_t limiar_pico_ddb = GRAVADOR_PICO_PADRAO_DDB;
+static volatile bool liberar_solicitado = false;
+
+// Exportação (núcleo 0)
+static uint32_t exportada;       // Número da última janela enviada
+static uint32_t exportar_bloco;  // Próximo bloco da janela a enviar
+
+static gravador_stats_t stats;   // disparos/ignorados: núcleo 1; exportadas: núcleo 0
+
+/**
+ * Nome de um gatilho para a exportação.
+ */
+static const char *gatilho_nome(gravador_gatilho_t gatilho) {
+    switch (gatilho) {
+        case GRAVADOR_GATILHO_NIVEL: return "nivel";
+        case GRAVADOR_GATILHO_PICO: return "pico";
+        case GRAVADOR_GATILHO_MICROFONIA: return "microfonia";
+        default: return "?";
+    }
+}
+
+/**
+ * Fecha a janela com o que já foi gravado depois do gatilho e a entrega ao
+ * núcleo 0. O anel para de ser escrito até a liberação.
+ */
+static void gravador_congelar() {
+    const uint32_t pos = GRAVADOR_POS_BLOCOS - pos_restantes;
+    gravacao.numero++;
+    gravacao.blocos = gravados;
+    gravacao.blocos_pre = gravados - pos;
+    primeiro_congelado = (proximo + GRAVADOR_BLOCOS - gravados) % GRAVADOR_BLOCOS;
+    stats.disparos++;
+
+    __dmb();  // Amostras e descrição visíveis ao núcleo 0 antes do novo estado
+    estado = GRAVADOR_CONGELADO;
+}
+
+/**
+ * Esquece o áudio gravado (núcleo 1, ao ligar ou desligar a captura: o
+ * fluxo fica descontínuo). Uma janela disparada é fechada com o que tiver;
+ * uma congelada continua esperando a exportação.
+ */
+void gravador_reiniciar() {
+    if (estado == GRAVADOR_DISPARADO)
+        gravador_congelar();
+    if (estado == GRAVADOR_GRAVANDO)
+        proximo = gravados = 0;
+#if GRAVADOR_ADPCM
+    adpcm_iniciar(&codificador);
+#endif
+    gatilhos_acima = 0;
+    bloco_pendente = false;
+}
+
+/**
+ * Destino do próximo bloco decimado (SAMPLES amostras), ou NULL enquanto
+ * uma janela congelada aguarda a exportação (núcleo 1).
+ */
+int16_t *gravador_proximo_bloco() {
+    if (estado == GRAVADOR_CONGELADO) {
+        if (!liberar_solicitado)
+            return NULL;
+        // Janela exportada: volta a gravar do zero
+        liberar_solicitado = false;
+        proximo = gravados = 0;
+#if GRAVADOR_ADPCM
+        adpcm_iniciar(&codificador);
+#endif
+        estado = GRAVADOR_GRAVANDO;
+    }
+    bloco_pendente = true;
+#if GRAVADOR_ADPCM
+    return entrada;
+#else
+    return (int16_t *)anel[proximo];
+#endif
+}
+
+/**
+ * Conclui o bloco entregue por gravador_proximo_bloco() e avalia os
+ * gatilhos com os níveis dele (núcleo 1, uma vez por bloco). Cada condição
+ * dispara só quando passa de inativa para ativa.
+ */
+void gravador_concluir_bloco(int16_t nivel_ddb, int16_t pico_ddb, bool microfonia) {
+    if (bloco_pendente) {
+        bloco_pendente = false;
+#if GRAVADOR_ADPCM
+        adpcm_codificar_bloco(&codificador, entrada, SAMPLES, anel[proximo]);
+#endif
+        proximo = (proximo + 1) % GRAVADOR_BLOCOS;
+        if (gravados < GRAVADOR_BLOCOS)
+            gravados++;
+        if (estado == GRAVADOR_DISPARADO && --pos_restantes == 0)
+            gravador_congelar();
+    }
+
+    const uint32_t gatilhos = gatilhos_solicitados;
+    uint32_t ativos = 0;
+    if ((gatilhos & GRAVADOR_GATILHO_NIVEL) && nivel_ddb >= limiar_nivel_ddb)
+        ativos |= GRAVADOR_GATILHO_NIVEL;
+    if ((gatilhos & GRAVADOR_GATILHO_PICO) && pico_ddb >= limiar_pico_ddb)
+        ativos |= GRAVADOR_GATILHO_PICO;
+    if ((gatilhos & GRAVADOR_GATILHO_MICROFONIA) && microfonia)
+        ativos |= GRAVADOR_GATILHO_MICROFONIA;
+
+    const uint32_t novos = ativos & ~gatilhos_acima;
+    gatilhos_acima = ativos;
+    if (novos == 0 || estado == GRAVADOR_DISPARADO)
+        return;
+    if (estado == GRAVADOR_CONGELADO || gravados == 0) {
+        stats.ignorados++;  // Sem áudio antes do gatilho ou janela anterior ainda por exportar
+        return;
+    }
+
+    // A janela pós-gatilho começa no próximo bloco
+    gravacao.gatilho = (gravador_gatilho_t)(novos & -novos);
+    gravacao.nivel_ddb = gravacao.gatilho == GRAVADOR_GATILHO_PICO ? pico_ddb : nivel_ddb;
+    gravacao.tempo_ms = to_ms_since_boot(get_absolute_time());
+    pos_restantes = GRAVADOR_POS_BLOCOS;
+    estado = GRAVADOR_DISPARADO;
+}
+
+/**
+ * Seleciona os gatilhos (máscara de gravador_gatilho_t) e os limiares de
+ * nível Fast e de true peak (0,1 dB). 0 desliga a gravação por evento.
+ */
+void gravador_set_gatilhos(uint32_t gatilhos, int16_t nivel_ddb, int16_t pico_ddb) {
+    limiar_nivel_ddb = nivel_ddb;
+    limiar_pico_ddb = pico_ddb;
+    gatilhos_solicitados = gatilhos;
+}
+
+/**
+ * Escreve n bytes em hexadecimal, terminando a string.
+ */
+static char *hex_bytes(char *p, const uint8_t *bytes, uint n) {
+    static const char hex[] = "0123456789abcdef";
+    for (uint i = 0; i < n; ++i) {
+        *p++ = hex[bytes[i] >> 4];
+        *p++ = hex[bytes[i] & 0xF];
+    }
+    *p = '\0';
+    return p;
+}
+
+/**
+ * Envia pela USB cerca de GRAVADOR_EXPORTAR_BYTES da janela congelada, em
+ * hexadecimal (bloco mais antigo primeiro), e libera o anel ao terminar:
+ * em PCM, linhas [PCM] com int16_t em complemento de 2 (big-endian, como se
+ * lê); em ADPCM, uma linha [ADPCM] por bloco, com os bytes na ordem de
+ * adpcm_codificar_bloco. ferramentas/gravacao.py converte para WAV.
+ * Chamada a cada volta do laço principal (núcleo 0); retorna true enquanto
+ * houver exportação em andamento.
+ */
+bool gravador_exportar_usb() {
+    if (estado != GRAVADOR_CONGELADO || gravacao.numero == exportada)
+        return false;
+    __dmb();  // Lê a janela só depois de observar o estado que a publicou
+
+    if (exportar_bloco == 0) {
+        printf("[GRAVACAO] Inicio #%u: gatilho %s (%.1f dB) em %u ms, %u Hz, %s, %u amostras, %u antes do gatilho\n",
+               (unsigned)gravacao.numero, gatilho_nome(gravacao.gatilho), gravacao.nivel_ddb / 10.f,
+               (unsigned)gravacao.tempo_ms, AUDIO_SAMPLE_RATE, GRAVADOR_ADPCM ? "ima-adpcm" : "pcm16",
+               (unsigned)(gravacao.blocos * SAMPLES),
+               (unsigned)(gravacao.blocos_pre * SAMPLES));
+    }
+
+    for (uint k = 0; k < GRAVADOR_EXPORTAR_BLOCOS && exportar_bloco < gravacao.blocos; ++k, ++exportar_bloco) {
+        const uint8_t *bloco = anel[(primeiro_congelado + exportar_bloco) % GRAVADOR_BLOCOS];
+#if GRAVADOR_ADPCM
+        static char linha[2 * GRAVADOR_BYTES_BLOCO + 1];
+        hex_bytes(linha, bloco, GRAVADOR_BYTES_BLOCO);
+        printf("[ADPCM] %s\n", linha);
+#else
+        const int16_t *amostras = (const int16_t *)bloco;
+        char linha[4 * GRAVADOR_AMOSTRAS_LINHA + 1];
+        for (uint i = 0; i < SAMPLES; i += GRAVADOR_AMOSTRAS_LINHA) {
+            char *p = linha;
+            for (uint j = 0; j < GRAVADOR_AMOSTRAS_LINHA; ++j) {
+                const uint8_t x[2] = {(uint8_t)((uint16_t)amostras[i + j] >> 8), (uint8_t)amostras[i + j]};
+                p = hex_bytes(p, x, 2);
+            }
+            printf("[PCM] %s\n", linha);
+        }
+#endif
+    }
+
+    if (exportar_bloco < gravacao.blocos)
+        return true;
+
+    printf("[GRAVACAO] Fim #%u\n", (unsigned)gravacao.numero);
+    exportada = gravacao.numero;
+    exportar_bloco = 0;
+    stats.exportadas++;
+    __dmb();  // Termina a leitura antes de devolver o anel ao núcleo 1
+    liberar_solicitado = true;
+    return true;
+}
+
+/**
+ * Copia os contadores do gravador.
+ */
+void gravador_get_stats(gravador_stats_t *stats_saida) {
+    *stats_saida = stats;
+}
@@ -58,6 +58,19 @@ inline static void ssd1306_write(ssd1306_t *p, uint8_t val) {
     fancy_write(p->i2c_i, p->address, d, 2, "ssd1306_write");
 }
 
+/* sends a whole command list in a single transaction (one control byte) */
+inline static void ssd1306_write_list(ssd1306_t *p, const uint8_t *cmds, size_t len) {
+    uint8_t d[32];
+    d[0]=0x00;
+    while(len) {
+        size_t n=len<sizeof(d)-1?len:sizeof(d)-1;
+        memcpy(d+1, cmds, n);
+        fancy_write(p->i2c_i, p->address, d, n+1, "ssd1306_write_list");
+        cmds+=n;
+        len-=n;
+    }
+}
+
 bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance) {
     p->width=width;
     p->height=height;
@@ -109,8 +122,7 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
         0x00,  // horizontal
     };
 
-    for(size_t i=0; i<sizeof(cmds); ++i)
-        ssd1306_write(p, cmds[i]);
+    ssd1306_write_list(p, cmds, sizeof(cmds));
 
     return true;
 }
@@ -297,8 +309,7 @@ void ssd1306_show(ssd1306_t *p) {
         payload[2]+=32;
     }
 
-    for(size_t i=0; i<sizeof(payload); ++i)
-        ssd1306_write(p, payload[i]);
+    ssd1306_write_list(p, payload, sizeof(payload));
 
     *(p->buffer-1)=0x40;
 
@@ -0,0 +1,26 @@
+#ifndef ADPCM_H
+#define ADPCM_H
+
+#include "pico/stdlib.h"
+
+// IMA-ADPCM: 4 bits por amostra de 16 bits (4:1). Cada bloco começa com o
+// estado do codificador (preditor em int16_t little-endian, índice do passo,
+// um byte livre), seguido das amostras em nibbles, o menos significativo
+// primeiro. O estado continua de um bloco para o outro, então o fluxo é o
+// mesmo de um codificador contínuo, mas qualquer bloco pode ser decodificado
+// sozinho (o anel do gravador descarta os mais antigos).
+#define ADPCM_CABECALHO 4
+#define ADPCM_BYTES_BLOCO(n) (ADPCM_CABECALHO + (n) / 2)  // n par
+
+// Estado do codificador (e do decodificador)
+typedef struct {
+    int16_t predito;            // Última amostra reconstruída
+    uint8_t indice;             // Posição na tabela de passos (0 .. 88)
+} adpcm_estado_t;
+
+// Declarações de funções
+void adpcm_iniciar(adpcm_estado_t *estado);
+uint adpcm_codificar_bloco(adpcm_estado_t *estado, const int16_t *amostras, uint n, uint8_t *saida);
+uint adpcm_decodificar_bloco(const uint8_t *entrada, uint n, int16_t *amostras);
+
+#endif // ADPCM_H
@@ -0,0 +1,38 @@
+#ifndef AGENDADOR_H
+#define AGENDADOR_H
+
+#include "pico/stdlib.h"
+
+// Agendador cooperativo do núcleo 0: tarefas periódicas que rodam até o fim
+// (sem preempção), escolhidas pelo prazo mais próximo (EDF, prazo = próxima
+// liberação). Sem tarefa pronta, o núcleo dorme em __wfe() até o alarme do
+// próximo prazo ou um __sev() do núcleo 1. Uma interrupção pode liberar uma
+// tarefa antes do período (agendador_liberar), com prazo imediato.
+#define AGENDADOR_MAX_TAREFAS 16
+
+typedef void (*agendador_funcao_t)(void);
+typedef void (*agendador_ocioso_t)(bool entrando);  // Chamado ao entrar e ao sair de uma espera longa
+
+// Tarefa registrada e seus contadores
+typedef struct {
+    const char *nome;
+    agendador_funcao_t funcao;
+    uint32_t periodo_us;
+    uint64_t liberacao_us;      // Próxima liberação (o prazo da execução atual é a seguinte)
+    volatile bool liberada;     // Liberada fora do período por agendador_liberar()
+    uint32_t execucoes;         // Execuções desde o último relatório
+    uint32_t atrasos;           // Liberações perdidas (a tarefa não rodou dentro do período)
+    uint32_t tempo_us;          // Tempo de execução acumulado desde o último relatório
+    uint32_t tempo_max_us;      // Execução mais longa desde o último relatório
+} agendador_tarefa_t;
+
+// Declarações de funções
+int agendador_adicionar(const char *nome, uint32_t periodo_ms, agendador_funcao_t funcao);
+void agendador_executar();
+void agendador_dormir_us(uint64_t duracao_us);
+void agendador_set_ocioso(uint32_t minimo_us, agendador_ocioso_t funcao);
+void agendador_set_periodo(int tarefa, uint32_t periodo_ms);
+void agendador_liberar(int tarefa);
+void agendador_relatorio();
+
+#endif // AGENDADOR_H
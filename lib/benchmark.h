@@ -0,0 +1,15 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "pico/stdlib.h"
+
+// Contador de ciclos baseado no SysTick (24 bits, clock do processador).
+// Mede intervalos de até 2^24 ciclos (~134 ms a 125 MHz).
+void ciclos_iniciar();
+uint32_t ciclos_agora();
+uint32_t ciclos_desde(uint32_t inicio);
+
+// Declarações de funções
+void benchmark_executar();
+
+#endif // BENCHMARK_H
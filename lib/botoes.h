@@ -0,0 +1,48 @@
+#ifndef BOTOES_H
+#define BOTOES_H
+
+#include "pico/stdlib.h"
+
+// Botões por interrupção: cada borda do GPIO arma um alarme de debounce que
+// confirma o nível; a máquina de estados de cada botão roda nas interrupções
+// e coloca os gestos numa fila para o núcleo 0, que é liberado na hora
+// (agendador_liberar). Botões ligados ao GND com pull-up interno.
+#define BOTOES_MAX 4
+#define BOTOES_DEBOUNCE_US 5000     // Nível estável por este tempo para valer
+#define BOTOES_DUPLO_MS 350         // Segundo toque até este tempo depois do primeiro soltar
+#define BOTOES_FILA_CAPACIDADE 16   // Gestos aguardando o núcleo 0 (potência de 2)
+
+// Gestos reconhecidos
+typedef enum {
+    BOTAO_PRESSIONADO,  // Pressionou (sai em todo toque, sem esperar a classificação)
+    BOTAO_CURTO,        // Soltou antes do tempo de toque longo e não houve outro toque em BOTOES_DUPLO_MS
+    BOTAO_LONGO,        // Continua pressionado depois do tempo de toque longo
+    BOTAO_DUPLO,        // Pressionou de novo logo depois de um toque curto
+} botao_gesto_t;
+
+typedef struct {
+    uint8_t botao;              // Índice retornado por botoes_adicionar()
+    uint8_t gesto;              // botao_gesto_t
+    uint64_t inicio_us;         // Borda que começou o toque
+    uint64_t referencia_us;     // Instante em que o gesto existiu (borda ou fim do tempo de toque longo)
+    uint64_t emitido_us;        // Instante em que entrou na fila
+} botao_evento_t;
+
+// Latência da borda até o reconhecimento (interrupção) e até o tratamento (núcleo 0)
+typedef struct {
+    uint32_t eventos;           // Gestos tratados
+    uint32_t descartados;       // Gestos perdidos por fila cheia
+    uint32_t deteccao_max_us;   // Maior latência até a fila
+    uint32_t tratamento_max_us; // Maior latência até botoes_obter_evento()
+    uint64_t tratamento_us;     // Soma das latências até botoes_obter_evento()
+} botoes_stats_t;
+
+// Declarações de funções
+int botoes_adicionar(uint pino, uint32_t longo_ms);
+void botoes_set_tarefa(int tarefa);
+bool botoes_pressionado(int botao);
+bool botoes_obter_evento(botao_evento_t *evento);
+void botoes_get_stats(botoes_stats_t *stats);
+void botoes_relatorio();
+
+#endif // BOTOES_H
@@ -0,0 +1,27 @@
+#ifndef CALIBRACAO_H
+#define CALIBRACAO_H
+
+#include "pico/stdlib.h"
+#include "lib/nucleo_dsp.h"
+
+// Calibração de campo com um calibrador acústico (tom de 1 kHz, onde as
+// ponderações A, C e Z coincidem)
+#define CALIBRACAO_NIVEL_DB 94.f     // Nível do calibrador (dB SPL)
+#define CALIBRACAO_MEDICOES 5        // Medições de 1 s combinadas
+#define CALIBRACAO_CORRECAO_MAX 20.f // Correção maior que esta indica calibrador ausente (dB)
+
+typedef enum {
+    CALIBRACAO_INATIVA,
+    CALIBRACAO_MEDINDO,
+    CALIBRACAO_CONCLUIDA,       // Aplicada e gravada na flash
+    CALIBRACAO_FALHOU
+} calibracao_estado_t;
+
+// Declarações de funções
+void calibracao_carregar();
+void calibracao_iniciar(float nivel_db);
+void calibracao_cancelar();
+bool calibracao_ativa();
+calibracao_estado_t calibracao_processar(const medicao_t *medicao);
+
+#endif // CALIBRACAO_H
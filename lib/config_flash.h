@@ -0,0 +1,41 @@
+#ifndef CONFIG_FLASH_H
+#define CONFIG_FLASH_H
+
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+
+// Armazenamento chave/valor nos últimos setores da flash. Cada gravação é
+// acrescentada ao fim do setor ativo; quando ele enche, os valores atuais
+// são copiados para o próximo setor (em rodízio), o que espalha os
+// apagamentos por todos os setores da área.
+#define CONFIG_SETORES 4
+#define CONFIG_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - CONFIG_SETORES * FLASH_SECTOR_SIZE)
+#define CONFIG_VALOR_MAX 64     // Maior valor aceito (bytes)
+
+// Chaves do armazenamento (cada uma com um único valor atual)
+typedef enum {
+    CONFIG_CALIBRACAO = 1,      // mic_calibracao_t: ganho e bias do microfone
+    CONFIG_LIMIARES,            // int16_t[MIC_LIMIARES]: limiares da classificação do volume (0,1 dB)
+    CONFIG_WIFI_SSID,           // Texto terminado em '\0'
+    CONFIG_WIFI_SENHA,
+    CONFIG_THINGSPEAK_CHAVE,
+    CONFIG_ADC_DNL,             // int16_t[ADC_DNL_PONTOS]: largura extra dos códigos com DNL (LSB, Q4)
+    CONFIG_CHAVES               // Número de chaves + 1
+} config_chave_t;
+
+// Contadores do armazenamento
+typedef struct {
+    uint32_t setor;             // Setor ativo (0 .. CONFIG_SETORES - 1)
+    uint32_t geracao;           // Compactações desde a primeira gravação (apagamentos = geracao / CONFIG_SETORES por setor)
+    uint32_t livre;             // Bytes livres no setor ativo
+    uint32_t registros_invalidos; // Registros corrompidos ignorados na leitura (gravação interrompida)
+} config_stats_t;
+
+// Declarações de funções
+void config_init();
+bool config_ler(config_chave_t chave, void *valor, uint tamanho);
+bool config_ler_texto(config_chave_t chave, char *texto, uint tamanho, const char *padrao);
+bool config_gravar(config_chave_t chave, const void *valor, uint tamanho);
+void config_get_stats(config_stats_t *stats);
+
+#endif // CONFIG_FLASH_H
@@ -0,0 +1,17 @@
+#ifndef DECIBEL_H
+#define DECIBEL_H
+
+#include "pico/stdlib.h"
+
+// Logaritmos em ponto fixo: log2 em Q16 (16 bits fracionários) e níveis em
+// milésimos de dB, com erro abaixo de 0,001 dB em toda a faixa
+#define LOG2_FRAC_BITS 16
+#define DECIBEL_MDB_ZERO INT32_MIN  // 10 * log10(0)
+
+// Declarações de funções
+int32_t log2_q16(uint64_t x);
+int32_t log2_q16_float(float x);
+int32_t potencia_para_mdb(uint64_t x);
+int32_t log2_q16_para_mdb(int32_t log2);
+
+#endif // DECIBEL_H
@@ -0,0 +1,40 @@
+#ifndef DECIMADOR_H
+#define DECIMADOR_H
+
+#include "pico/stdlib.h"
+
+// Estrutura do decimador: CIC de ordem DECIMADOR_ESTAGIOS decimando por
+// fator / 2, seguido de um FIR que compensa a queda do CIC na banda de
+// passagem e decima pelos 2 restantes. O fator total deve ser par e o
+// fator do CIC no máximo DECIMADOR_CIC_MAX (ganho do CIC em 32 bits).
+#define DECIMADOR_ESTAGIOS 4
+#define DECIMADOR_TAPS 41           // Coeficientes do FIR (ímpar e simétrico)
+#define DECIMADOR_CIC_MAX 12
+
+typedef struct {
+    uint32_t fator_cic;             // Decimação do CIC
+    uint32_t fase;                  // Amostras de entrada acumuladas para a próxima saída do CIC
+    uint32_t integrador[DECIMADOR_ESTAGIOS];  // Aritmética modular: o estouro é intencional
+    uint32_t pente[DECIMADOR_ESTAGIOS];       // Saída anterior de cada integrador (atraso dos pentes)
+    uint32_t ganho_cic;             // Ganho do CIC (fator_cic ^ DECIMADOR_ESTAGIOS)
+    int32_t bias;                   // Bias do ADC (códigos com AUDIO_FRAC_BITS bits fracionários)
+    uint32_t bias_cic;              // Bias na escala da saída do CIC
+    uint32_t desloca;               // Shift na saída do CIC (deixa ~16 a 32 x o código do ADC)
+    uint32_t desloca_codigos;       // Shift para a entrada em códigos crus
+    const uint16_t *linearizacao;   // Valor de cada código (AUDIO_FRAC_BITS bits fracionários) ou NULL
+    int32_t coef[DECIMADOR_TAPS / 2 + 1];    // Metade do FIR (Q14), já com o resto do ganho do CIC
+    int32_t historico[2 * DECIMADOR_TAPS];   // Linha de atraso circular duplicada (janela contígua)
+    uint32_t pos;                   // Próxima posição de escrita no histórico
+    bool impar;                     // O FIR só calcula uma de cada duas saídas do CIC
+} decimador_t;
+
+// Declarações de funções
+void decimador_init(decimador_t *d, uint32_t fator);
+void decimador_reiniciar(decimador_t *d);
+void decimador_set_bias(decimador_t *d, int32_t bias);
+void decimador_set_linearizacao(decimador_t *d, const uint16_t *tabela);
+uint decimador_processar(decimador_t *d, const uint16_t *entrada, uint n, int32_t *saida,
+                         uint32_t *saturadas_min, uint32_t *saturadas_max);
+float decimador_ganho_enob(uint32_t fator);
+
+#endif // DECIMADOR_H
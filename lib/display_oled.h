@@ -3,18 +3,61 @@
 
 #include "pico/stdlib.h"
 #include "inc/ssd1306.h" // Inclua a biblioteca SSD1306
+#include "lib/grafico.h"
 #include <string.h>
 #include <stdio.h>
 
+// Quadro do SSD1306 128x64: o desenho fica na memória até display_atualizar(),
+// que envia só as colunas de cada página que mudaram desde o envio anterior,
+// por DMA e sem esperar o barramento
+#ifndef DISPLAY_I2C_HZ
+#define DISPLAY_I2C_HZ 400000  // 1000000 (fast mode plus) com a opção SOUNDMONITOR_OLED_FM_PLUS
+#endif
+#define DISPLAY_LARGURA 128
+#define DISPLAY_PAGINAS 8
+#define DISPLAY_BYTES_JANELA 10  // Custo fixo de uma janela no I2C: 8 bytes de comandos + endereço e controle dos dados
+#define DISPLAY_BYTES_QUADRO_INTEIRO (DISPLAY_BYTES_JANELA + DISPLAY_LARGURA * DISPLAY_PAGINAS)  // ssd1306_show()
+#define HISTORICO_DB_MIN 30.f  // Base do gráfico de histórico e da barra
+#define HISTORICO_DB_MAX 100.f  // Topo
+#define HISTORICO_Y 16          // Histórico nas páginas 2 a 7
+#define ESPECTRO_DB_MIN 20.f    // Base das barras das bandas de oitava
+#define ESPECTRO_DB_MAX 90.f    // Topo
+#define ESPECTRO_Y 16           // Barras das bandas nas páginas 2 a 6, frequências na 7
+#define DISPLAY_PALAVRAS_QUADRO (DISPLAY_PAGINAS * (8 + DISPLAY_LARGURA))  // Pior caso: uma janela inteira por página
+
+// Envios ao display
+typedef struct {
+    uint32_t quadros;           // Chamadas de display_atualizar()
+    uint32_t janelas;           // Janelas enviadas no último quadro
+    uint32_t bytes_ultimo;      // Bytes no I2C no último quadro (endereços inclusos)
+    uint64_t bytes_total;
+    uint32_t tempo_ultimo_us;   // CPU do último display_atualizar() (o envio segue por DMA)
+    uint32_t tempo_max_us;
+    uint64_t tempo_total_us;
+    uint32_t erros;             // Quadros com falha no I2C (o seguinte vai inteiro)
+} display_stats_t;
+
+extern ssd1306_t disp;
+
 // Declarações das funções
 void inicializa();
 void print_texto(char *msg, uint32_t x, uint32_t y, uint32_t scale);
 void print_linha(int x1, int y1, int x2, int y2);
 void print_retangulo(int x1, int y1, int x2, int y2);
 void limpar_tela();
+void display_atualizar();
+void display_esperar();
+void display_invalidar();
+void display_get_stats(display_stats_t *stats);
+void display_relatorio();
 void exibir_barra_carregamento(int porcentagem);
-void exibir_tela_desligar(void);
+void exibir_tela_desligar(int passo);
 void exibir_tela_pronto(void);
+void exibir_tela_nivel(const char *volume_str, const char *db_str);
+void exibir_alerta_microfonia(float frequencia);
+void exibir_tela_calibracao(float nivel_db, const char *estado);
+void exibir_tela_historico(grafico_historico_t *historico, const char *nivel_str, float nivel_db, bool completo);
+void exibir_tela_espectro(const int16_t *oitava_ddb, uint bandas, const char *nivel_str, float nivel_db, bool completo);
 void timer_milliseconds(int milliseconds);
 
 
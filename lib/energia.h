@@ -0,0 +1,65 @@
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include "pico/stdlib.h"
+
+// Modo de baixo consumo (unidades a bateria): a captura roda só em janelas
+// de medição, o clk_sys cai para 48 MHz (PLL_USB, PLL_SYS desligado) nas
+// esperas longas do núcleo 0 com a captura pausada e o CYW43 fica em
+// economia de energia entre os envios.
+#ifndef ENERGIA_BAIXO_CONSUMO_PADRAO
+#define ENERGIA_BAIXO_CONSUMO_PADRAO false
+#endif
+#define ENERGIA_CLOCK_KHZ 125000        // clk_sys normal
+#define ENERGIA_CLOCK_LENTO_KHZ 48000   // clk_sys nas esperas
+#define ENERGIA_OCIOSO_MIN_US 20000     // Espera mínima para valer a troca de clock (religar o PLL leva ~1 ms)
+#define ENERGIA_CICLO_MS 10000          // Uma medição de 1 s a cada ENERGIA_CICLO_MS
+#define ENERGIA_ENVIO_MS 60000          // Intervalo entre envios ao ThingSpeak
+#define ENERGIA_WIFI_ATIVO_MS 3000      // Wi-Fi fora da economia durante cada envio
+
+// Corrente média estimada de cada parte em cada estado (mA em VSYS);
+// valores típicos da Pico W, a ajustar com medições da placa
+#define ENERGIA_MA_CLOCK_RAPIDO 24.f
+#define ENERGIA_MA_CLOCK_LENTO 9.f
+#define ENERGIA_MA_CAPTURA 3.f          // ADC + DMA + núcleo 1 processando
+#define ENERGIA_MA_WIFI_DESEMPENHO 45.f  // CYW43_PERFORMANCE_PM: rádio sempre ligado
+#define ENERGIA_MA_WIFI_PADRAO 12.f      // CYW43_DEFAULT_PM
+#define ENERGIA_MA_WIFI_ECONOMIA 2.5f    // CYW43_AGGRESSIVE_PM
+
+// Estados contabilizados (o clock é um ou outro; captura e Wi-Fi somam)
+typedef enum {
+    ENERGIA_CLOCK_RAPIDO,
+    ENERGIA_CLOCK_LENTO,
+    ENERGIA_CAPTURA,
+    ENERGIA_WIFI_DESEMPENHO,
+    ENERGIA_WIFI_PADRAO,
+    ENERGIA_WIFI_ECONOMIA,
+    ENERGIA_ESTADOS
+} energia_estado_t;
+
+// Tempo em cada estado e carga estimada desde o boot
+typedef struct {
+    uint64_t tempo_us[ENERGIA_ESTADOS];
+    uint32_t trocas_clock;      // Vezes que o clk_sys caiu para ENERGIA_CLOCK_LENTO_KHZ
+    float carga_mah;            // Soma de tempo x corrente de todos os estados
+} energia_stats_t;
+
+// Modo de energia do Wi-Fi
+typedef enum {
+    ENERGIA_WIFI_DESLIGADO,
+    ENERGIA_WIFI_MODO_DESEMPENHO,
+    ENERGIA_WIFI_MODO_PADRAO,
+    ENERGIA_WIFI_MODO_ECONOMIA,
+} energia_wifi_t;
+
+// Declarações de funções
+void energia_init();
+void energia_set_baixo_consumo(bool ligado);
+bool energia_baixo_consumo();
+void energia_ocioso(bool entrando);
+void energia_captura(bool ligada);
+void energia_wifi(energia_wifi_t modo);
+void energia_get_stats(energia_stats_t *stats);
+void energia_relatorio();
+
+#endif // ENERGIA_H
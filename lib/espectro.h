@@ -0,0 +1,46 @@
+#ifndef ESPECTRO_H
+#define ESPECTRO_H
+
+#include "pico/stdlib.h"
+
+// Tamanho da FFT: potência de 4 (radix-4). 4^5 = 1024 pontos, ~21 ms e
+// bins de 46,9 Hz a 48 kHz: as bandas abaixo de ~160 Hz ficam com menos de
+// um bin e são só aproximadas. Com 6 (4096 pontos, 11,7 Hz) elas melhoram,
+// ao custo de 4x a memória e ~5x o tempo por quadro.
+#define ESPECTRO_LOG4N 5
+#define ESPECTRO_N (1u << (2 * ESPECTRO_LOG4N))
+
+// Bandas de 1/3 de oitava de 25 Hz a 16 kHz e de oitava de 31,5 Hz a 16 kHz
+// (frequências centrais de base 10, IEC 61260). Bandas acima de Nyquist ficam zeradas.
+#define ESPECTRO_BANDAS_TERCO 29
+#define ESPECTRO_BANDAS_OITAVA 10
+
+// Faixa de bins (com pesos fracionários nas bordas) que forma uma banda
+typedef struct {
+    uint16_t k_ini, k_fim;     // Primeiro e último bin (inclusive)
+    uint16_t peso_ini, peso_fim; // Fração (Q16) dos bins das bordas dentro da banda
+} banda_t;
+
+// Analisador de espectro: acumula amostras janeladas e calcula a FFT a cada ESPECTRO_N amostras
+typedef struct {
+    int16_t dados[2 * ESPECTRO_N];  // Complexos intercalados (re, im) em Q15, processados no lugar
+    uint32_t preenchidas;           // Amostras já janeladas no quadro atual
+    uint32_t potencia[ESPECTRO_N / 2]; // |X[k]|^2 do último quadro, em escala 2^(2 * expoente)
+    int32_t expoente;               // Expoente do ponto flutuante em blocos do último quadro
+    uint32_t quadros;               // Quadros processados desde a última leitura das bandas
+    banda_t terco[ESPECTRO_BANDAS_TERCO];
+    banda_t oitava[ESPECTRO_BANDAS_OITAVA];
+    uint64_t energia_terco[ESPECTRO_BANDAS_TERCO];   // Soma, sobre os quadros, da potência de cada banda
+    uint64_t energia_oitava[ESPECTRO_BANDAS_OITAVA];
+} espectro_t;
+
+// Declarações de funções
+void espectro_init(espectro_t *esp, uint32_t taxa_amostragem);
+void espectro_reiniciar(espectro_t *esp);
+uint espectro_adicionar(espectro_t *esp, const int32_t *amostras, uint n);
+int32_t fft_radix4_q15(int16_t *dados);
+uint32_t espectro_bandas(espectro_t *esp, uint64_t *terco, uint64_t *oitava);
+float espectro_frequencia_terco(uint banda);
+float espectro_frequencia_oitava(uint banda);
+
+#endif // ESPECTRO_H
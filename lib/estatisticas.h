@@ -0,0 +1,61 @@
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include "pico/stdlib.h"
+
+// Faixa e resolução do histograma de níveis
+#define EST_DB_MIN 0            // Nível mínimo representado (dB); abaixo disso vai para o primeiro bin
+#define EST_DB_MAX 140          // Nível máximo representado (dB); acima disso vai para o último bin
+#define EST_BINS ((EST_DB_MAX - EST_DB_MIN) * 10)  // Bins de 0,1 dB
+
+// Janelas de agregação. Cada uma é formada por subjanelas completas da
+// anterior (1 h = 4 x 15 min, 15 min = 15 x 1 min); não se guarda nenhuma
+// amostra, só histogramas e somas de energia.
+//
+// Custo de memória por janela: EST_BINS * 4 bytes de histograma + ~24 bytes
+// de acumuladores = 5624 bytes com a faixa padrão (0 a 140 dB), ou seja,
+// ~16,5 KB para as três janelas, mais um acumulador temporário (5,5 KB)
+// usado nas consultas das janelas em andamento.
+typedef enum {
+    EST_JANELA_1MIN = 0,
+    EST_JANELA_15MIN,
+    EST_JANELA_1H,
+    EST_JANELAS
+} est_janela_t;
+
+// Acumulador de uma janela em andamento
+typedef struct {
+    uint32_t histograma[EST_BINS];  // Blocos por nível (0,1 dB)
+    uint64_t soma_quadratica;       // Soma das médias quadráticas dos blocos (para o Leq)
+    uint32_t blocos;                // Blocos acumulados
+    uint32_t subjanelas;            // Subjanelas completas já incorporadas
+    int16_t min_ddb, max_ddb;       // Menor e maior nível (0,1 dB)
+} est_acumulador_t;
+
+// Resultado de uma janela (níveis em décimos de dB)
+typedef struct {
+    uint32_t numero;    // Janelas completas desde o início (0 = nenhuma ainda)
+    uint32_t blocos;    // Blocos que formam o resultado
+    int16_t leq;        // Nível equivalente contínuo
+    int16_t lmin, lmax; // Menor e maior nível
+    int16_t l10, l50, l90; // Níveis excedidos em 10%, 50% e 90% do tempo
+} est_resultado_t;
+
+// Conversão de média quadrática (unidades internas^2) para décimos de dB
+typedef int16_t (*est_para_ddb_t)(uint64_t media_quadratica);
+
+// Motor de estatísticas
+typedef struct {
+    est_acumulador_t acumulador[EST_JANELAS];
+    est_resultado_t ultima[EST_JANELAS];  // Última janela completa de cada tamanho
+    uint32_t blocos_por_minuto;
+    est_para_ddb_t para_ddb;
+} estatisticas_t;
+
+// Declarações de funções
+void estatisticas_init(estatisticas_t *est, uint32_t blocos_por_minuto, est_para_ddb_t para_ddb);
+void estatisticas_reiniciar(estatisticas_t *est);
+void estatisticas_adicionar(estatisticas_t *est, uint64_t media_quadratica, int16_t nivel_ddb);
+void estatisticas_parcial(const estatisticas_t *est, est_janela_t janela, est_resultado_t *resultado);
+
+#endif // ESTATISTICAS_H
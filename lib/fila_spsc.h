@@ -0,0 +1,27 @@
+#ifndef FILA_SPSC_H
+#define FILA_SPSC_H
+
+#include "pico/stdlib.h"
+
+// Fila circular sem travas para um único produtor e um único consumidor
+// (tipicamente em núcleos diferentes). Os itens têm tamanho fixo e são
+// copiados para dentro/fora da fila. A capacidade deve ser potência de 2.
+typedef struct {
+    uint8_t *dados;                  // Armazenamento dos itens (capacidade * tamanho_item bytes)
+    uint32_t tamanho_item;           // Tamanho de cada item em bytes
+    uint32_t mascara;                // capacidade - 1
+    volatile uint32_t cabeca;        // Próxima posição de escrita (só o produtor altera)
+    volatile uint32_t cauda;         // Próxima posição de leitura (só o consumidor altera)
+    volatile uint32_t descartados;   // Itens rejeitados por fila cheia (só o produtor altera)
+    volatile uint32_t profundidade_max; // Maior ocupação já observada (só o produtor altera)
+} fila_spsc_t;
+
+// Declarações de funções
+void fila_spsc_init(fila_spsc_t *fila, void *armazenamento, uint32_t tamanho_item, uint32_t capacidade);
+bool fila_spsc_push(fila_spsc_t *fila, const void *item);
+void *fila_spsc_reservar(fila_spsc_t *fila);
+void fila_spsc_publicar(fila_spsc_t *fila);
+bool fila_spsc_pop(fila_spsc_t *fila, void *item);
+uint32_t fila_spsc_profundidade(const fila_spsc_t *fila);
+
+#endif // FILA_SPSC_H
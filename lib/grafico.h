@@ -0,0 +1,34 @@
+#ifndef GRAFICO_H
+#define GRAFICO_H
+
+#include "pico/stdlib.h"
+#include "inc/ssd1306.h"
+
+// Primitivas inteiras no quadro do SSD1306 (coordenadas fora da tela são
+// cortadas): linhas de Bresenham e preenchimentos por byte de página, em vez
+// de um ssd1306_draw_pixel por ponto.
+#define GRAFICO_HISTORICO_MAX 128  // Colunas de histórico (uma por medição)
+
+// Histórico em varredura: cada ponto novo ocupa a coluna do cursor e apaga a
+// seguinte (a lacuna marca o fim), sem rolar o resto. Só duas colunas mudam
+// por ponto, e o envio por diferença do display manda só elas.
+typedef struct {
+    int x, y, largura, altura;      // Área do gráfico na tela
+    float minimo, maximo;           // Faixa de valores (base e topo da área)
+    uint8_t pontos[GRAFICO_HISTORICO_MAX];  // Altura em pixels de cada coluna
+    uint32_t total;                 // Pontos adicionados desde o início
+    uint32_t desenhados;            // Pontos já desenhados no quadro
+} grafico_historico_t;
+
+// Declarações de funções
+void grafico_linha(ssd1306_t *p, int x0, int y0, int x1, int y1);
+void grafico_preencher(ssd1306_t *p, int x, int y, int largura, int altura, bool aceso);
+void grafico_linha_h(ssd1306_t *p, int x0, int x1, int y);
+void grafico_linha_v(ssd1306_t *p, int x, int y0, int y1);
+void grafico_contorno(ssd1306_t *p, int x, int y, int largura, int altura);
+void grafico_barra(ssd1306_t *p, int x, int y, int largura, int altura, float valor, float minimo, float maximo);
+void grafico_historico_init(grafico_historico_t *h, int x, int y, int largura, int altura, float minimo, float maximo);
+void grafico_historico_adicionar(grafico_historico_t *h, float valor);
+void grafico_historico_desenhar(ssd1306_t *p, grafico_historico_t *h, bool completo);
+
+#endif // GRAFICO_H
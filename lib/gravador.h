@@ -0,0 +1,76 @@
+#ifndef GRAVADOR_H
+#define GRAVADOR_H
+
+#include "pico/stdlib.h"
+#include "lib/microfone.h"  // SAMPLES e AUDIO_SAMPLE_RATE
+#include "lib/adpcm.h"      // Compressão 4:1 do anel
+
+// Anel com os últimos segundos do áudio decimado (antes da ponderação), no
+// formato interno em 16 bits: códigos do ADC com AUDIO_FRAC_BITS bits
+// fracionários, que cobrem exatamente a escala do int16_t. Com GRAVADOR_ADPCM
+// cada bloco é guardado em IMA-ADPCM (4x mais áudio na mesma memória). Um
+// gatilho congela a janela (pré + pós-gatilho) até o núcleo 0 terminar de
+// exportá-la; a medição não para enquanto isso.
+#ifndef GRAVADOR_KB
+#define GRAVADOR_KB 96          // Memória do anel (KB): 4 s a 48 kHz em ADPCM, 1 s em PCM
+#endif
+#ifndef GRAVADOR_ADPCM
+#define GRAVADOR_ADPCM 1
+#endif
+#if GRAVADOR_ADPCM
+#define GRAVADOR_BYTES_BLOCO ADPCM_BYTES_BLOCO(SAMPLES)
+#else
+#define GRAVADOR_BYTES_BLOCO (SAMPLES * 2u)
+#endif
+#define GRAVADOR_BLOCOS (GRAVADOR_KB * 1024u / GRAVADOR_BYTES_BLOCO)  // Blocos inteiros no anel
+#define GRAVADOR_POS_BLOCOS (GRAVADOR_BLOCOS / 4)  // Um quarto da janela fica depois do gatilho
+#define GRAVADOR_EXPORTAR_BYTES 4096  // Enviados pela USB a cada chamada (não trava o laço principal)
+
+#if GRAVADOR_POS_BLOCOS == 0
+#error "GRAVADOR_KB pequeno demais para a janela pós-gatilho"
+#endif
+
+// Condições que disparam a gravação (combináveis)
+typedef enum {
+    GRAVADOR_GATILHO_NIVEL = 1 << 0,      // Nível Fast ponderado acima do limiar
+    GRAVADOR_GATILHO_PICO = 1 << 1,       // True peak do bloco acima do limiar
+    GRAVADOR_GATILHO_MICROFONIA = 1 << 2, // Alerta do detector de microfonia
+} gravador_gatilho_t;
+
+#define GRAVADOR_GATILHOS_PADRAO (GRAVADOR_GATILHO_PICO | GRAVADOR_GATILHO_MICROFONIA)
+#define GRAVADOR_NIVEL_PADRAO_DDB 900  // 90 dB
+#define GRAVADOR_PICO_PADRAO_DDB 1100  // 110 dB
+
+// Estado do anel (só o núcleo 1 altera)
+typedef enum {
+    GRAVADOR_GRAVANDO,          // Guardando continuamente o áudio mais recente
+    GRAVADOR_DISPARADO,         // Gatilho recebido: completando a janela pós-gatilho
+    GRAVADOR_CONGELADO,         // Janela pronta, aguardando a exportação
+} gravador_estado_t;
+
+// Descrição de uma janela congelada
+typedef struct {
+    uint32_t numero;            // Gravações congeladas desde o boot (1 = primeira)
+    gravador_gatilho_t gatilho; // Condição que disparou
+    uint32_t tempo_ms;          // Instante do gatilho (ms desde o boot)
+    int16_t nivel_ddb;          // Nível que disparou (0,1 dB; nível Fast ou true peak)
+    uint32_t blocos;            // Blocos de SAMPLES amostras na janela
+    uint32_t blocos_pre;        // Blocos antes do gatilho (inclui o bloco do gatilho)
+} gravacao_info_t;
+
+// Contadores do gravador
+typedef struct {
+    uint32_t disparos;          // Gatilhos que congelaram uma janela
+    uint32_t ignorados;         // Gatilhos recebidos com uma janela ainda por exportar
+    uint32_t exportadas;        // Janelas enviadas pela USB
+} gravador_stats_t;
+
+// Declarações de funções
+void gravador_reiniciar();
+int16_t *gravador_proximo_bloco();
+void gravador_concluir_bloco(int16_t nivel_ddb, int16_t pico_ddb, bool microfonia);
+void gravador_set_gatilhos(uint32_t gatilhos, int16_t nivel_ddb, int16_t pico_ddb);
+bool gravador_exportar_usb();
+void gravador_get_stats(gravador_stats_t *stats);
+
+#endif // GRAVADOR_H
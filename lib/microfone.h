@@ -4,24 +4,101 @@
 #include "pico/stdlib.h"
 #include "hardware/adc.h"
 #include "hardware/dma.h"
+#include "lib/potencia.h" // ADC_BIAS_CODE e RMS dos blocos crus
 #include <math.h>
 
 // Definições de pinos e constantes
 #define MIC_CHANNEL 2
 #define MIC_PIN (26 + MIC_CHANNEL)
-#define ADC_CLOCK_DIV 48.f
-#define SAMPLES 400
+
+// O ADC sobreamostra e o decimador (CIC + FIR) entrega o áudio na taxa
+// AUDIO_SAMPLE_RATE, escolhida na compilação (16, 32 ou 48 kHz)
+#ifndef AUDIO_SAMPLE_RATE
+#define AUDIO_SAMPLE_RATE 48000 // Taxa do áudio entregue ao processamento (Hz)
+#endif
+#define ADC_CAPTURE_RATE 384000 // Taxa de conversão do ADC (Hz)
+#define DECIMACAO_FATOR (ADC_CAPTURE_RATE / AUDIO_SAMPLE_RATE)
+#if ADC_CAPTURE_RATE % AUDIO_SAMPLE_RATE != 0 || DECIMACAO_FATOR % 2 != 0
+#error "AUDIO_SAMPLE_RATE deve dividir ADC_CAPTURE_RATE com fator par"
+#endif
+#define ADC_CLOCK_DIV (48000000.f / ADC_CAPTURE_RATE - 1.f)  // Período do ADC = (1 + div) ciclos de 48 MHz
+#define AUDIO_BLOCOS_POR_SEGUNDO 100
+#define SAMPLES (AUDIO_SAMPLE_RATE / AUDIO_BLOCOS_POR_SEGUNDO)  // Amostras de áudio por bloco (10 ms)
+#define ADC_SAMPLES_BLOCO (SAMPLES * DECIMACAO_FATOR)         // Códigos do ADC por bloco do DMA
 #define ADC_ADJUST(x) ((x) * 3.3f / (1 << 12u) - 1.65f)
+#define ADC_CODES_TO_VOLTS(x) ((x) * 3.3f / (1 << 12u))
+#define AUDIO_FRAC_BITS 4       // Amostras internas (int32_t): códigos do ADC sem DC com 4 bits fracionários
 #define ADC_MAX 3.3f
 #define ADC_STEP (3.3f/5.f)
-#define FILTER_SIZE 5
+#define ADC_CODIGO_MAX 4095     // Maior código do ADC de 12 bits (0 e 4095 indicam saturação)
+
+// Interpolador do true peak: sobreamostragem 4x com 12 coeficientes por fase
+#define TRUE_PEAK_FATOR 4
+#define TRUE_PEAK_TAPS 12
+
+// Correções da captura, ligáveis em tempo de execução (mic_set_correcoes):
+// linearização dos códigos com DNL alto do ADC do RP2040 (errata RP2040-E11)
+// na entrada do decimador e remoção adaptativa do nível DC depois dele
+#define ADC_DNL_PONTOS 4
+#define ADC_DNL_CODIGOS {512, 1536, 2560, 3584}  // Códigos mais largos que 1 LSB
+#define ADC_DNL_LARGURA_Q4 (8 << 4)              // Largura extra típica de cada um (LSB com 4 bits fracionários)
+#define MIC_LINEARIZAR_PADRAO true
+#define MIC_REMOVER_DC_PADRAO true
+#define MIC_DC_CORTE_HZ 2.f                       // Corte do passa-altas que acompanha o DC
+
+// Referências dos níveis em dB (0,001 dB): 0 dB em 0,1 mV, ou seja,
+// 20 * log10(1 / 0,0001) para tensões em volts e 20 * log10(3,3 / 4096 /
+// 2^AUDIO_FRAC_BITS / 0,0001) para médias quadráticas no formato interno
+#define MIC_REFERENCIA_TENSAO_MDB 80000
+#define MIC_REFERENCIA_MEDIA_MDB (-5959)
+
+// Classificação do volume: limiares padrão (0,1 dB) entre as MIC_LIMIARES + 1 faixas
+#define MIC_LIMIARES 5
+#define MIC_LIMIARES_PADRAO {300, 430, 550, 600, 900}
+
+// Calibração do microfone (gravada na flash, ver config_flash.h)
+typedef struct {
+    int32_t ganho_mdb;         // Correção somada a todos os níveis em dB (0,001 dB)
+    int32_t bias;              // Nível DC da entrada (códigos do ADC com AUDIO_FRAC_BITS bits fracionários)
+} mic_calibracao_t;
+
+// Contadores da captura contínua
+typedef struct {
+    uint32_t blocks_captured;  // Blocos completados pelo DMA
+    uint32_t blocks_dropped;   // Blocos descartados porque o consumidor não os retirou a tempo
+    uint32_t blocks_overrun;   // Blocos sobrescritos pelo DMA enquanto ainda eram processados
+    uint32_t samples_clipped_low;  // Amostras no código 0 desde o boot (ganho analógico saturando)
+    uint32_t samples_clipped_high; // Amostras no código ADC_CODIGO_MAX desde o boot
+} mic_capture_stats_t;
+
+// Medidas de um bloco do ADC tiradas na mesma passada da decimação
+typedef struct {
+    uint64_t energia;          // Soma dos quadrados sem ponderação (formato interno)
+    int32_t pico;              // Maior |amostra| (formato interno)
+    int32_t soma;              // Soma das amostras antes da remoção do DC: nível que sobrou depois do bias
+    uint32_t saturadas_min;    // Códigos 0 na entrada do decimador
+    uint32_t saturadas_max;    // Códigos ADC_CODIGO_MAX na entrada do decimador
+} mic_bloco_info_t;
 
 // Declarações de funções
 void microphone_init();
-void sample_mic();
-float mic_power();
-float apply_moving_average_filter(float new_value);
+void mic_capture_start();
+void mic_capture_stop();
+const uint16_t* mic_capture_acquire();
+void mic_capture_release();
+void mic_capture_get_stats(mic_capture_stats_t *stats);
+void mic_convert_block(const uint16_t *buffer, int32_t *amostras, uint n);
+uint mic_analisar_bloco(const uint16_t *buffer, uint n, int32_t *amostras, int16_t *gravacao,
+                        mic_bloco_info_t *info);
+int32_t mic_true_peak(const int32_t *amostras, uint n, int32_t pico);
+uint64_t mic_energy_samples(const int32_t *amostras, uint n);
+void mic_set_calibracao(const mic_calibracao_t *calibracao);
+void mic_get_calibracao(mic_calibracao_t *calibracao);
+void mic_set_limiares(const int16_t *limiares_ddb);
+void mic_set_dnl(const int16_t *larguras_q4);
+void mic_set_correcoes(bool linearizar, bool remover_dc);
 float calculate_db(float voltage);
+int32_t mic_media_quadratica_para_mdb(uint64_t media);
 const char* classify_volume(float db);
 
 #endif // MICROPHONE_H
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef MICROFONIA_H
+#define MICROFONIA_H
+
+#include "pico/stdlib.h"
+#include "lib/espectro.h"  // ESPECTRO_N e espectro de potência por quadro
+
+// Picos estreitos acompanhados ao mesmo tempo (e eventos por quadro, no máximo)
+#define MICROFONIA_CANDIDATOS 4
+
+// Critérios de detecção, aplicados a cada quadro da FFT. Só picos que
+// crescem são alarmados: notas sustentadas (órgão, acordes) ficam estáveis
+// ou decaem, enquanto a microfonia cresce até saturar. Uma microfonia que já
+// estava saturada quando o detector começou só é vista quando recomeça.
+#define MICROFONIA_F_MIN 80              // Faixa analisada (Hz); acima de 16 kHz não é áudio útil
+#define MICROFONIA_F_MAX 16000
+#define MICROFONIA_DESTAQUE_DDB 150      // Pico >= 15 dB acima da média logarítmica dos bins do quadro
+#define MICROFONIA_VIZINHOS_LOG2 3       // ... e >= 2^3 (9 dB) acima dos bins a +-3 (fora do lóbulo da janela)
+#define MICROFONIA_PERSISTENCIA_MS 120   // Tempo mínimo acompanhando o pico antes de alarmar
+#define MICROFONIA_CRESCIMENTO_DDB 30    // Crescimento mínimo no período (0,1 dB)
+#define MICROFONIA_QUEDA_DDB 15          // Queda entre quadros que conta contra o crescimento (0,1 dB)
+#define MICROFONIA_SALTO_DDB 60          // Subida num só quadro que indica ataque de nota: recomeça o acompanhamento
+
+// Pico estreito em acompanhamento
+typedef struct {
+    uint16_t bin;            // Bin do pico no último quadro (0 = posição livre)
+    uint16_t quadros;        // Quadros consecutivos em que o pico apareceu
+    uint16_t quedas;         // Quadros em que o nível caiu mais que MICROFONIA_QUEDA_DDB
+    bool alarmado;           // Evento já emitido para este pico
+    int32_t nivel_ini;       // Nível (log2 em Q8, escala absoluta) no primeiro quadro
+    int32_t nivel;           // Nível no último quadro
+} microfonia_candidato_t;
+
+// Evento publicado quando um pico é classificado como microfonia
+typedef struct {
+    uint32_t tempo_ms;       // Instante da detecção (ms desde o boot)
+    float frequencia;        // Frequência estimada (Hz, interpolada entre bins)
+    int16_t destaque_ddb;    // Quanto o pico está acima da média logarítmica do espectro (0,1 dB)
+    int16_t crescimento_ddb; // Crescimento desde que o pico apareceu (0,1 dB)
+    uint16_t duracao_ms;     // Tempo de acompanhamento até a detecção
+} microfonia_evento_t;
+
+// Detector de microfonia sobre os quadros do analisador de espectro
+typedef struct {
+    microfonia_candidato_t candidatos[MICROFONIA_CANDIDATOS];
+    uint16_t k_min, k_max;   // Faixa de bins analisada
+    uint16_t quadros_min;    // Quadros equivalentes a MICROFONIA_PERSISTENCIA_MS
+    int32_t destaque_q8;     // MICROFONIA_DESTAQUE_DDB em log2 Q8
+    int32_t queda_q8;        // MICROFONIA_QUEDA_DDB em log2 Q8
+    int32_t salto_q8;        // MICROFONIA_SALTO_DDB em log2 Q8
+    float resolucao;         // Hz por bin
+    float ms_por_quadro;
+} microfonia_t;
+
+// Declarações de funções
+void microfonia_init(microfonia_t *m, uint32_t taxa_amostragem);
+void microfonia_reiniciar(microfonia_t *m);
+uint microfonia_quadro(microfonia_t *m, const uint32_t *potencia, int32_t expoente, microfonia_evento_t *eventos);
+
+#endif // MICROFONIA_H
@@ -0,0 +1,67 @@
+#ifndef NUCLEO_DSP_H
+#define NUCLEO_DSP_H
+
+#include "pico/stdlib.h"
+#include "lib/microfone.h"  // SAMPLES e AUDIO_SAMPLE_RATE
+#include "lib/ponderacao.h" // Ponderação em frequência
+#include "lib/estatisticas.h" // Resultados por janela
+#include "lib/espectro.h"   // Número de bandas
+#include "lib/microfonia.h" // Eventos de microfonia
+
+// Blocos do DMA combinados em cada medição publicada (1 segundo de áudio)
+#define DSP_BLOCOS_POR_MEDICAO AUDIO_BLOCOS_POR_SEGUNDO
+#define DSP_FILA_CAPACIDADE 8   // Medições que cabem na fila entre os núcleos (potência de 2)
+#define DSP_PONDERACAO_PADRAO PONDERACAO_A  // Ponderação em frequência ao ligar
+#define DSP_FILA_MICROFONIA_CAPACIDADE 8    // Eventos de microfonia aguardando o núcleo 0 (potência de 2)
+#define DSP_MICROFONIA_PADRAO true          // Detector de microfonia ligado ao iniciar
+#define DSP_PICO_RETENCAO_MS 2000           // Tempo que o pico retido fica parado antes de decair
+#define DSP_PICO_DECAIMENTO_DDB_S 120       // Decaimento do pico retido depois disso (0,1 dB/s)
+#define DSP_RETOMADA_DESCARTE_BLOCOS 5      // Blocos ignorados ao sair da pausa (transitório do decimador)
+#define DSP_SUSPENSAO_TIMEOUT_MS 50         // Espera máxima pelo núcleo 1 parar o DMA antes de gravar na flash
+
+// Registro de tamanho fixo publicado pelo núcleo 1 a cada medição
+typedef struct {
+    uint32_t sequencia;          // Número da medição desde o boot
+    uint32_t tempo_ms;           // Instante da publicação (ms desde o boot)
+    float rms;                   // Tensão RMS equivalente do intervalo (V)
+    float db;                    // Nível equivalente do intervalo (dB, na ponderação abaixo)
+    float db_tempo[PONDERACAO_TEMPO_N]; // Nível com ponderação temporal F/S/I no fim do intervalo (dB)
+    est_resultado_t est_parcial[EST_JANELAS];  // Janelas de 1 min / 15 min / 1 h em andamento
+    est_resultado_t est_completa[EST_JANELAS]; // Última janela completa de cada tamanho
+    int16_t terco_ddb[ESPECTRO_BANDAS_TERCO];   // Nível de cada banda de 1/3 de oitava no intervalo (0,1 dB Z)
+    int16_t oitava_ddb[ESPECTRO_BANDAS_OITAVA]; // Nível de cada banda de oitava no intervalo (0,1 dB Z)
+    int16_t pico_ddb;            // Maior pico de amostra do intervalo (0,1 dB, sem ponderação)
+    int16_t pico_real_ddb;       // Maior true peak (sobreamostragem 4x) do intervalo (0,1 dB)
+    int16_t pico_retido_ddb;     // True peak com retenção e decaimento no fim do intervalo (0,1 dB)
+    int16_t fator_crista_ddb;    // True peak menos o nível equivalente sem ponderação (0,1 dB)
+    uint32_t saturadas_min;      // Amostras no código 0 durante o intervalo
+    uint32_t saturadas_max;      // Amostras no código 4095 durante o intervalo
+    int32_t dc;                  // Nível DC médio que sobrou depois do bias (formato interno)
+    uint16_t carga_decimacao_pm; // Tempo do núcleo 1 na decimação (por mil do tempo real)
+    uint16_t carga_dsp_pm;       // Tempo do núcleo 1 no processamento completo dos blocos (por mil)
+    ponderacao_freq_t ponderacao; // Ponderação em frequência aplicada
+    uint32_t blocos;             // Blocos do DMA combinados nesta medição
+    uint32_t blocos_perdidos;    // Total de blocos descartados pela captura
+    uint32_t blocos_sobrescritos; // Total de blocos sobrescritos durante o processamento
+} medicao_t;
+
+// Estado da fila de medições entre os núcleos
+typedef struct {
+    uint32_t profundidade;       // Medições aguardando o núcleo 0
+    uint32_t profundidade_max;   // Maior ocupação já observada
+    uint32_t descartados;        // Medições perdidas por fila cheia
+} nucleo_dsp_stats_t;
+
+// Declarações de funções
+void nucleo_dsp_iniciar();
+void nucleo_dsp_ligar(bool ligado);
+void nucleo_dsp_pausar(bool pausado);
+bool nucleo_dsp_suspender(bool suspenso);
+void nucleo_dsp_set_ponderacao(ponderacao_freq_t tipo);
+bool nucleo_dsp_obter_medicao(medicao_t *medicao);
+void nucleo_dsp_set_microfonia(bool ligado);
+void nucleo_dsp_set_retencao_pico(uint32_t retencao_ms, uint32_t decaimento_ddb_s);
+bool nucleo_dsp_obter_microfonia(microfonia_evento_t *evento);
+void nucleo_dsp_get_stats(nucleo_dsp_stats_t *stats);
+
+#endif // NUCLEO_DSP_H
@@ -0,0 +1,93 @@
+#ifndef PERFIL_H
+#define PERFIL_H
+
+#include "pico/stdlib.h"
+
+// Perfil das etapas do caminho quente: cada medição custa duas leituras do
+// timer de 64 bits e algumas somas, e fica compilada também nas versões de
+// produção. Cada etapa é atualizada por um único núcleo. Com PERFIL_ATIVO=0
+// as medições somem do código.
+#ifndef PERFIL_ATIVO
+#define PERFIL_ATIVO 1
+#endif
+#define PERFIL_HISTOGRAMA 16        // Faixas de 2^k a 2^(k+1)-1 us; a última junta tudo acima de 32 ms
+#define PERFIL_PINTURA 0xA5A5A5A5u  // Palavra pintada nas pilhas para a marca d'água
+
+// Etapas medidas
+typedef enum {
+    // Núcleo 1, a cada bloco de 10 ms
+    PERFIL_DECIMACAO,       // Decimação, DC, saturação, energia e cópia para o gravador
+    PERFIL_TRUE_PEAK,       // Sobreamostragem 4x do pico
+    PERFIL_ESPECTRO,        // FFT por quadro e detector de microfonia
+    PERFIL_NIVEL,           // Ponderação em frequência, energia, F/S/I e estatísticas
+    PERFIL_GRAVADOR,        // Codificação do bloco gravado e gatilhos
+    PERFIL_PUBLICACAO,      // Montagem e envio da medição ao núcleo 0 (uma por segundo)
+    // Núcleo 0
+    PERFIL_LEDS,            // Desenho da matriz de LEDs
+    PERFIL_LEDS_ESCRITA,    // npWrite: envio dos 25 LEDs ao PIO
+    PERFIL_OLED,            // Desenho da tela normal
+    PERFIL_OLED_TEXTO,      // Cada print_texto (desenho no quadro)
+    PERFIL_OLED_ENVIO,      // display_atualizar: envio das páginas alteradas
+    PERFIL_REDE,            // cyw43_arch_poll
+    PERFIL_ENVIO,           // send_data_to_thingspeak
+    PERFIL_ETAPAS
+} perfil_etapa_id_t;
+
+// Estatísticas de uma etapa desde o boot
+typedef struct {
+    uint32_t contagem;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t histograma[PERFIL_HISTOGRAMA];
+} perfil_etapa_t;
+
+// Uso de memória (bytes)
+typedef struct {
+    uint32_t heap_total;        // Do fim do .bss ao fim da RAM
+    uint32_t heap_usado;        // Alocado agora (malloc)
+    uint32_t heap_max;          // Maior área já pedida ao sbrk
+    uint32_t pilha_total[2];    // Pilha de cada núcleo
+    uint32_t pilha_max[2];      // Maior profundidade já alcançada (marca d'água)
+} perfil_memoria_t;
+
+extern perfil_etapa_t perfil_etapas[PERFIL_ETAPAS];
+
+/**
+ * Início de uma medição: guarda o retorno e passe-o a perfil_fim().
+ */
+static inline uint64_t perfil_inicio() {
+#if PERFIL_ATIVO
+    return time_us_64();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Fim de uma medição: soma a duração desde inicio_us à etapa.
+ */
+static inline void perfil_fim(perfil_etapa_id_t etapa, uint64_t inicio_us) {
+#if PERFIL_ATIVO
+    uint32_t duracao = (uint32_t)(time_us_64() - inicio_us);
+    perfil_etapa_t *e = &perfil_etapas[etapa];
+    uint faixa = 31 - __builtin_clz(duracao | 1);
+    e->histograma[faixa < PERFIL_HISTOGRAMA ? faixa : PERFIL_HISTOGRAMA - 1]++;
+    if (e->contagem == 0 || duracao < e->min_us)
+        e->min_us = duracao;
+    if (duracao > e->max_us)
+        e->max_us = duracao;
+    e->total_us += duracao;
+    e->contagem++;
+#else
+    (void)etapa;
+    (void)inicio_us;
+#endif
+}
+
+// Declarações de funções
+void perfil_init();
+void perfil_get_memoria(perfil_memoria_t *memoria);
+void perfil_relatorio();
+
+#endif // PERFIL_H
@@ -0,0 +1,57 @@
+#ifndef PONDERACAO_H
+#define PONDERACAO_H
+
+#include "pico/stdlib.h"
+
+// Ponderações em frequência (IEC 61672-1)
+typedef enum {
+    PONDERACAO_Z = 0,   // Sem ponderação (resposta plana)
+    PONDERACAO_A,       // Curva A: dB(A)
+    PONDERACAO_C        // Curva C: dB(C)
+} ponderacao_freq_t;
+
+#define PONDERACAO_MAX_SECOES 3   // A: 2 passa-altas + 1 passa-baixas; C: 1 + 1
+#define PONDERACAO_GUARDA 8       // Bits fracionários extras dentro da cascata (ruído de arredondamento)
+
+// Seção biquadrática com zeros duplos fixos: só os polos têm coeficientes
+typedef struct {
+    int32_t a1, a2;     // Coeficientes do denominador em Q30
+    int8_t zeros;       // +1: zeros em z = 1, -1: zeros em z = -1, 0: sem zeros
+    int32_t x1, x2;     // Entradas anteriores
+    int32_t y1, y2;     // Saídas anteriores
+} biquad_t;
+
+// Filtro de ponderação: cascata de biquads em ponto fixo
+typedef struct {
+    ponderacao_freq_t tipo;
+    uint8_t secoes;
+    biquad_t biquad[PONDERACAO_MAX_SECOES];
+    int32_t ganho;      // Ganho final em Q30 (normaliza 1 kHz para 0 dB)
+} filtro_ponderacao_t;
+
+// Ponderações temporais (constantes de tempo do medidor de nível sonoro)
+typedef enum {
+    PONDERACAO_RAPIDA = 0,  // Fast (F): 125 ms
+    PONDERACAO_LENTA,       // Slow (S): 1 s
+    PONDERACAO_IMPULSO,     // Impulse (I): 35 ms subindo, 1,5 s descendo
+    PONDERACAO_TEMPO_N
+} ponderacao_tempo_t;
+
+// Integrador exponencial da média quadrática, atualizado uma vez por bloco
+typedef struct {
+    ponderacao_tempo_t tipo;
+    uint32_t alfa_subida;   // 1 - exp(-T_bloco / tau) em Q16, quando o nível sobe
+    uint32_t alfa_descida;  // Idem, quando o nível desce
+    uint64_t media;         // Média quadrática ponderada (unidades internas^2) em Q16
+} integrador_tempo_t;
+
+// Declarações de funções
+void ponderacao_init(filtro_ponderacao_t *filtro, ponderacao_freq_t tipo, uint32_t taxa_amostragem);
+void ponderacao_processar(filtro_ponderacao_t *filtro, int32_t *amostras, uint n);
+const char* ponderacao_nome(ponderacao_freq_t tipo);
+void integrador_tempo_init(integrador_tempo_t *integrador, ponderacao_tempo_t tipo, uint amostras_bloco, uint32_t taxa_amostragem);
+void integrador_tempo_atualizar(integrador_tempo_t *integrador, uint64_t energia_bloco, uint amostras_bloco);
+uint64_t integrador_tempo_valor(const integrador_tempo_t *integrador);
+const char* ponderacao_tempo_nome(ponderacao_tempo_t tipo);
+
+#endif // PONDERACAO_H
@@ -0,0 +1,16 @@
+#ifndef POTENCIA_H
+#define POTENCIA_H
+
+#include "pico/stdlib.h"
+
+// Potência e RMS de blocos crus do ADC. Não depende do hardware: também
+// compila no PC para os testes em testes/.
+#define ADC_BIAS_CODE 2048      // Código do ADC correspondente ao bias de 1,65 V do microfone
+
+// Declarações de funções
+float mic_power(const uint16_t *buffer, uint n);
+uint64_t mic_energy(const uint16_t *buffer, uint n);
+uint32_t isqrt64(uint64_t x);
+uint32_t mic_power_fixed(const uint16_t *buffer, uint n);
+
+#endif // POTENCIA_H
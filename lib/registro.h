@@ -0,0 +1,62 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include "pico/stdlib.h"
+#include "lib/registro_formatos.h"  // Lista de formatos
+
+// Registro binário adiado: em vez de formatar com printf, o ponto de
+// registro grava o número do formato e os argumentos crus (32 bits cada)
+// numa fila sem travas do seu núcleo; uma tarefa do núcleo 0 esvazia as
+// filas pela USB como linhas "[R] <hex>", que ferramentas/registro.py
+// transforma de volta em texto. Fila cheia descarta e conta o registro.
+// Pode ser usado em interrupções (os callbacks do lwIP rodam numa): a
+// gravação desliga as interrupções do núcleo, que fica com um só produtor.
+#define REGISTRO_MAX_ARGS 10
+#define REGISTRO_CAPACIDADE 64      // Registros por núcleo aguardando a USB (potência de 2)
+#define REGISTRO_DRENAR_MAX 16      // Registros enviados por execução da tarefa
+#define REGISTRO_TEXTO_MAX 24       // Bytes enviados de cada argumento %s
+
+#define REGISTRO_ID(id, formato) id,
+typedef enum {
+    REGISTRO_FORMATOS(REGISTRO_ID)
+    REGISTRO_NUM_FORMATOS
+} registro_formato_t;
+#undef REGISTRO_ID
+
+// Registro como fica na fila
+typedef struct {
+    uint32_t tempo_us;          // time_us_32() no ponto de registro
+    uint16_t formato;           // registro_formato_t
+    uint8_t num_args;
+    uint32_t args[REGISTRO_MAX_ARGS];
+} registro_t;
+
+// Contadores por núcleo desde o boot
+typedef struct {
+    uint32_t escritos[2];
+    uint32_t perdidos[2];       // Descartados por fila cheia
+    uint32_t profundidade_max[2];
+} registro_stats_t;
+
+// Argumentos: inteiros vão direto; float e texto passam pelas funções abaixo
+static inline uint32_t registro_f(float valor) {
+    union { float f; uint32_t u; } bits = {.f = valor};
+    return bits.u;
+}
+static inline uint32_t registro_s(const char *texto) {
+    return (uint32_t)(uintptr_t)texto;  // O texto precisa continuar válido até ser enviado
+}
+
+// REGISTRO(REG_X, arg1, arg2, ...): grava o registro e retorna (sem formatar)
+#define REGISTRO(formato, ...)                                             \
+    registro_escrever((formato), (const uint32_t[]){__VA_ARGS__},           \
+                      sizeof((const uint32_t[]){__VA_ARGS__}) / sizeof(uint32_t))
+
+// Declarações de funções
+void registro_init();
+void registro_escrever(registro_formato_t formato, const uint32_t *args, uint num_args);
+uint registro_drenar(uint maximo);
+void registro_get_stats(registro_stats_t *stats);
+void registro_relatorio();
+
+#endif // REGISTRO_H
@@ -0,0 +1,28 @@
+#ifndef REGISTRO_FORMATOS_H
+#define REGISTRO_FORMATOS_H
+
+// Formatos do registro binário: X(identificador, "formato printf"). O
+// número do formato é a posição na lista; ferramentas/registro.py lê este
+// arquivo para decodificar, então só acrescente formatos no fim. Conversões
+// aceitas: %d %i %u %x %X %c %f %e %g (32 bits) e %s (só textos constantes).
+#define REGISTRO_FORMATOS(X) \
+    X(REG_PERDIDOS, "[REGISTRO] %u registros perdidos no nucleo %u") \
+    X(REG_DADOS_NIVEL, "[DADOS] L%seq: %5.2f, L%sF: %5.2f, L%sS: %5.2f, L%sI: %5.2f dB, Volume: %s") \
+    X(REG_DADOS_PICOS, "[DADOS] Pico: %.1f dB, True peak: %.1f dB, Pico retido: %.1f dB, Fator de crista: %.1f dB") \
+    X(REG_AVISO_SATURACAO, "[AVISO] ADC saturado: %u amostras em 0 e %u em 4095 - reduza o ganho do microfone") \
+    X(REG_DADOS_FILA, "[DADOS] Blocos perdidos: %u, Sobrescritos: %u, Fila: %u (max %u), Descartes: %u") \
+    X(REG_DADOS_CARGA, "[DADOS] Carga do nucleo 1: decimacao %.1f%%, total %.1f%%") \
+    X(REG_ESTAT, "[ESTAT] %s: L%seq %.1f, Lmax %.1f, Lmin %.1f, L10 %.1f, L50 %.1f, L90 %.1f dB") \
+    X(REG_MICROFONIA, "[MICROFONIA] %.1f Hz, %.1f dB acima do espectro, +%.1f dB em %u ms") \
+    X(REG_ENVIO_SEM_WIFI, "[INFO] WiFi desconectado. Não é possível enviar dados.") \
+    X(REG_ENVIO_INICIO, "[INFO] Iniciando envio de dados para o ThingSpeak...") \
+    X(REG_ENVIO_DNS, "[INFO] Endereço IP do ThingSpeak resolvido: %u.%u.%u.%u") \
+    X(REG_ENVIO_ERRO_DNS, "[ERRO] Erro na resolução de DNS") \
+    X(REG_ENVIO_ERRO_TCP, "[ERRO] Erro ao criar conexão TCP") \
+    X(REG_ENVIO_CONECTADO, "[INFO] Conectado ao servidor!") \
+    X(REG_ENVIO_ERRO_CONEXAO, "[ERRO] Falha ao conectar ao servidor") \
+    X(REG_ENVIO_OK, "[DADOS] Dados enviados com sucesso!") \
+    X(REG_BENCH, "[BENCH] Registro de teste %u: %.2f dB, %d, %s") \
+    X(REG_ENVIO_ERRO_TAMANHO, "[ERRO] Requisicao de %u bytes nao cabe em %u: envio descartado")
+
+#endif // REGISTRO_FORMATOS_H
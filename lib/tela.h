@@ -0,0 +1,50 @@
+#ifndef TELA_H
+#define TELA_H
+
+#include "pico/stdlib.h"
+
+// Telas retidas: cada tela é uma lista de widgets (rótulos fixos, textos e
+// barras ligados a valores). Os rótulos são desenhados uma vez numa camada de
+// fundo guardada; depois, cada tela_mostrar() redesenha só os widgets cujo
+// valor mudou, e o envio por diferença do display manda só a área deles.
+// Qualquer desenho fora das telas (limpar_tela) invalida a tela retida.
+#define TELA_TEXTO_MAX 32  // Texto de um widget, com o terminador (cabe "Volume: Extremamente Alto")
+
+typedef enum {
+    WIDGET_ROTULO,  // Texto fixo, parte da camada de fundo
+    WIDGET_TEXTO,   // Texto ligado a um valor (tela_texto)
+    WIDGET_BARRA    // Barra ligada a um valor (tela_barra)
+} widget_tipo_t;
+
+typedef struct {
+    widget_tipo_t tipo;
+    uint8_t x, y, largura, altura;  // Caixa apagada antes de redesenhar (textos e barras)
+    uint8_t escala;                 // Escala da fonte (rótulos e textos)
+    const char *rotulo;             // Texto do rótulo
+    float minimo, maximo;           // Faixa da barra
+    // Estado
+    char texto[TELA_TEXTO_MAX];     // Texto atual
+    int16_t preenchido;             // Pixels acesos da barra
+    bool alterado;                  // Valor mudou desde o último desenho
+} widget_t;
+
+typedef struct {
+    widget_t *widgets;
+    uint num_widgets;
+} tela_t;
+
+// Declaração dos widgets (caixas de texto com a altura da fonte na escala)
+#define TELA_ROTULO(px, py, esc, txt) {.tipo = WIDGET_ROTULO, .x = (px), .y = (py), .escala = (esc), .rotulo = (txt)}
+#define TELA_TEXTO(px, py, esc, larg) \
+    {.tipo = WIDGET_TEXTO, .x = (px), .y = (py), .largura = (larg), .altura = 8 * (esc), .escala = (esc)}
+#define TELA_BARRA(px, py, larg, alt, min, max) \
+    {.tipo = WIDGET_BARRA, .x = (px), .y = (py), .largura = (larg), .altura = (alt), .minimo = (min), .maximo = (max)}
+#define TELA(widgets) {(widgets), sizeof(widgets) / sizeof((widgets)[0])}
+
+// Declarações de funções
+void tela_texto(tela_t *tela, uint widget, const char *texto);
+void tela_barra(tela_t *tela, uint widget, float valor);
+uint tela_mostrar(tela_t *tela);
+void tela_invalidar();
+
+#endif // TELA_H
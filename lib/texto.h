@@ -0,0 +1,16 @@
+#ifndef TEXTO_H
+#define TEXTO_H
+
+#include "pico/stdlib.h"
+#include "inc/ssd1306.h"
+
+// Texto com a fonte 8x5 do driver direto nos bytes das páginas do quadro:
+// cada coluna do glifo vira um OR por página (alinhado) ou dois com
+// deslocamento (y fora da página), sem passar por ssd1306_draw_pixel. As
+// escalas 2 e 3 usam colunas já esticadas, montadas no primeiro uso.
+#define TEXTO_ESCALA_MAX 3  // Escalas acima disso usam o desenho por pixel do driver
+
+// Declarações de funções
+void texto_desenhar(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t escala, const char *s);
+
+#endif // TEXTO_H
@@ -0,0 +1,43 @@
+#ifndef TRANSPORTE_I2C_H
+#define TRANSPORTE_I2C_H
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+// Transporte I2C sem bloqueio: uma lista de palavras do IC_DATA_CMD (byte +
+// bit de STOP) vai inteira por DMA para a FIFO de transmissão; cada STOP
+// fecha uma transação e a próxima palavra abre outra (START) no mesmo
+// endereço. O fim vem da interrupção de STOP do I2C, que chama o callback.
+// NACK, perda de arbitragem ou barramento travado (prazo estourado) disparam
+// a recuperação: 9 pulsos de SCL, STOP manual e o I2C reiniciado.
+#define TRANSPORTE_I2C_HZ 400000           // Fast mode
+#define TRANSPORTE_I2C_HZ_FM_PLUS 1000000  // Fast mode plus (pull-ups fortes no barramento)
+#define TRANSPORTE_I2C_ERROS_FM_PLUS 3     // Erros seguidos no fast mode plus antes de voltar a 400 kHz
+#define TRANSPORTE_I2C_FOLGA_US 5000       // Folga do prazo sobre o tempo teórico da transferência
+
+// Palavra do IC_DATA_CMD: byte de dados, com STOP no último byte da transação
+#define TRANSPORTE_I2C_DADO(byte) ((uint16_t)(byte))
+#define TRANSPORTE_I2C_FIM(byte) ((uint16_t)((byte) | I2C_IC_DATA_CMD_STOP_BITS))
+
+typedef void (*transporte_i2c_fim_t)(bool ok, void *dados);
+
+// Contadores desde o início
+typedef struct {
+    uint32_t transferencias;
+    uint64_t bytes;             // Bytes de dados na linha (sem os endereços)
+    uint32_t tempo_ultimo_us;   // Do início ao último STOP da transferência anterior
+    uint32_t tempo_max_us;
+    uint32_t erros;             // NACK, perda de arbitragem ou prazo estourado
+    uint32_t recuperacoes;      // Barramento liberado e I2C reiniciado
+    uint32_t baudrate;          // Frequência atual do SCL
+} transporte_i2c_stats_t;
+
+// Declarações de funções
+void transporte_i2c_init(i2c_inst_t *i2c, uint pino_sda, uint pino_scl, uint32_t baudrate);
+bool transporte_i2c_enviar(uint8_t endereco, const uint16_t *palavras, uint num_palavras,
+                           transporte_i2c_fim_t fim, void *dados);
+bool transporte_i2c_ocupado();
+bool transporte_i2c_esperar();
+void transporte_i2c_get_stats(transporte_i2c_stats_t *stats);
+
+#endif // TRANSPORTE_I2C_H
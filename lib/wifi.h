@@ -4,12 +4,24 @@
 #include "pico/cyw43_arch.h"
 #include "lwip/tcp.h"
 #include "lwip/dns.h"
+#include "lib/energia.h"
+
+// Andamento da conexão assíncrona
+typedef enum {
+    WIFI_CONEXAO_ANDAMENTO,
+    WIFI_CONEXAO_PRONTA,
+    WIFI_CONEXAO_FALHOU
+} wifi_conexao_t;
 
 // Declarações das funções
-bool inicializar_wifi();
+bool wifi_iniciar_conexao();
+wifi_conexao_t wifi_verificar_conexao();
 bool connect_to_wifi();
 bool send_data_to_thingspeak(float db_level);
+bool send_feedback_to_thingspeak(float frequencia);
+void send_bands_to_thingspeak(const int16_t *oitava_ddb);
 void timer_seconds(int seconds);
+void wifi_set_modo_energia(energia_wifi_t modo);
 
 
 // Declaração da variável global
@@ -5,6 +5,17 @@
 #include <stdio.h>  // Biblioteca para entrada/saida padrao
 #include "lib/wifi.h"  // Biblioteca para conexao Wi-Fi
 #include "lib/display_oled.h"  // Biblioteca para controle do display OLED
+#include "lib/nucleo_dsp.h"  // Captura e processamento do microfone no nucleo 1
+#include "lib/benchmark.h"  // Benchmarks de desempenho (SOUNDMONITOR_BENCHMARK)
+#include "lib/decimador.h"  // Ganho de resolucao da decimacao
+#include "lib/config_flash.h"  // Configuracao e calibracao gravadas na flash
+#include "lib/calibracao.h"  // Calibracao de campo com calibrador de 94 dB
+#include "lib/gravador.h"  // Gravacao do audio em volta de eventos sonoros
+#include "lib/agendador.h"  // Tarefas periodicas do nucleo 0
+#include "lib/energia.h"  // Modo de baixo consumo e contabilidade de energia
+#include "lib/botoes.h"  // Botoes por interrupcao (debounce e gestos)
+#include "lib/perfil.h"  // Tempo das etapas e uso de memoria
+#include "lib/registro.h"  // Registro binario adiado (decodificado por ferramentas/registro.py)
 
 
 // Variavel global para armazenar o nivel de decibels (dB)
@@ -13,13 +24,502 @@ float current_db_level = 0.0f;
 // Definicao dos pinos dos botoes
 #define BUTTON_A_PIN 5 // Botao para ligar o projeto
 #define BUTTON_B_PIN 6 // Botao para desligar o projeto (Segurar ele para desligar)
+#define CALIBRACAO_SEGURAR_MS 3000 // Segurar A com o projeto ligado inicia a calibracao
+#define DESLIGAR_SEGURAR_MS 1000 // Segurar B com o projeto ligado desliga
+int botao_a, botao_b;
 
 // Variavel para controlar o estado do projeto (ligado/desligado)
 bool projeto_ligado = false;
+uint64_t projeto_ligado_us = 0;  // Fim da ligacao (o toque que ligou nao vira calibracao)
+
+// Ponderacao temporal (F/S/I) consumida por cada saida
+ponderacao_tempo_t oled_ponderacao_tempo = PONDERACAO_RAPIDA;
+ponderacao_tempo_t led_ponderacao_tempo = PONDERACAO_RAPIDA;
+ponderacao_tempo_t envio_ponderacao_tempo = PONDERACAO_LENTA;
+
+// O que a matriz de LEDs mostra: nivel (padrao) ou espectro por oitava
+led_modo_t led_modo = LED_MODO_NIVEL;
+
+// Tela do OLED: nivel (padrao), historico do nivel ou bandas de oitava, em ciclo a cada toque em B
+typedef enum {
+    OLED_TELA_NIVEL,
+    OLED_TELA_HISTORICO,
+    OLED_TELA_ESPECTRO,
+    OLED_TELAS
+} oled_tela_t;
+oled_tela_t oled_tela = OLED_TELA_NIVEL;
+grafico_historico_t historico_db;  // Um ponto por medicao, na ponderacao do OLED
+
+// Alerta de microfonia: OLED e LEDs ficam no alerta por este tempo apos cada evento
+#define MICROFONIA_ALERTA_MS 3000
+absolute_time_t microfonia_alerta_ate = 0;
+
+// Periodo de cada tarefa do nucleo 0 (ms)
+#define TAREFA_BOTOES_MS 100  // Os gestos liberam a tarefa na hora; o periodo e so reserva
+#define TAREFA_SEQUENCIA_MS 20
+#define TAREFA_EVENTOS_MS 20
+#define TAREFA_MEDICAO_MS 100
+#define TAREFA_LEDS_MS 100
+#define TAREFA_OLED_MS 250
+#define TAREFA_REDE_MS 10
+#define TAREFA_ENVIO_MS 1000
+#define TAREFA_EXPORTACAO_MS 10
+#define TAREFA_RELATORIO_MS 10000
+#define TAREFA_CICLO_MS 100
+#define TAREFA_COMANDOS_MS 100
+#define TAREFA_REGISTRO_MS 20
+#define TAREFA_BAIXO_CONSUMO_MS 100  // Tarefas rapidas no modo de baixo consumo (acordam juntas)
+
+// Tarefas cujo periodo muda no modo de baixo consumo
+int tarefa_id_eventos, tarefa_id_rede, tarefa_id_exportacao, tarefa_id_registro, tarefa_id_sequencia;
+
+// Captura pausada entre as janelas do modo de baixo consumo
+bool captura_pausada = false;
+absolute_time_t proxima_janela = 0;
+
+// Ligacao e desligamento em passos curtos, conduzidos pela tarefa "sequencia":
+// botoes, rede e as demais tarefas continuam rodando entre um passo e outro
+typedef enum {
+    SEQUENCIA_PARADA,
+    SEQUENCIA_CARREGANDO,  // Barra de progresso, 10% por passo
+    SEQUENCIA_PRONTO,      // Tela de pronto
+    SEQUENCIA_WIFI,        // Projeto ligado; aguardando a conexao ao Wi-Fi
+    SEQUENCIA_DESLIGANDO   // Animacao de desligamento
+} sequencia_t;
+sequencia_t sequencia = SEQUENCIA_PARADA;
+int sequencia_passo = 0;
+absolute_time_t sequencia_proximo = 0;  // Fim do passo atual (prazo da conexao em SEQUENCIA_WIFI)
+#define LIGAR_PASSO_MS 200
+#define LIGAR_PRONTO_MS 500
+#define WIFI_TIMEOUT_MS 10000
+#define DESLIGAR_PASSO_MS 520
+#define DESLIGAR_PASSOS 6
+
+// Resultado da calibracao fica na tela ate oled_retido_ate
+#define CALIBRACAO_RESULTADO_MS 2000
+absolute_time_t oled_retido_ate = 0;
+
+// Medicao mais recente do nucleo 1 e a ultima mostrada em cada saida
+medicao_t ultima_medicao;
+bool medicao_valida = false;
+uint32_t medicao_leds = UINT32_MAX;
+uint32_t medicao_oled = UINT32_MAX;
+bool alerta_na_tela = false;
+
+// Muda a etapa da ligacao/desligamento; a seguinte comeca daqui a espera_ms
+void sequencia_ir(sequencia_t etapa, uint32_t espera_ms) {
+    sequencia = etapa;
+    sequencia_proximo = make_timeout_time_ms(espera_ms);
+}
+
+// Liga o projeto: primeiro passo da barra de progresso (a tarefa "sequencia" segue dai)
+void ligar_projeto() {
+    sequencia_passo = 10;
+    exibir_barra_carregamento(sequencia_passo);
+    sequencia_ir(SEQUENCIA_CARREGANDO, LIGAR_PASSO_MS);
+}
+
+// Fim da tela de inicio: captura continua do microfone no nucleo 1 e Wi-Fi
+// conectando em segundo plano (a medicao nao espera a rede)
+void iniciar_projeto() {
+    projeto_ligado = true;
+    printf("\n[PROJECT] Projeto ligado!\n");
+
+    medicao_valida = false;
+    medicao_leds = medicao_oled = UINT32_MAX;
+    grafico_historico_init(&historico_db, 0, HISTORICO_Y, DISPLAY_LARGURA, DISPLAY_PAGINAS * 8 - HISTORICO_Y,
+                           HISTORICO_DB_MIN, HISTORICO_DB_MAX);
+    captura_pausada = false;
+    proxima_janela = make_timeout_time_ms(ENERGIA_CICLO_MS);
+    nucleo_dsp_pausar(false);
+    nucleo_dsp_ligar(true);
+    energia_captura(true);
+    projeto_ligado_us = time_us_64();
+
+    printf("[INFO] Tentativa de conexao ao Wi-Fi...\n");
+    if (wifi_iniciar_conexao()) {
+        sequencia_ir(SEQUENCIA_WIFI, WIFI_TIMEOUT_MS);
+    } else {
+        printf("[INFO] Nao foi possivel conectar ao Wi-Fi. O projeto continuara sem Wi-Fi.\n");
+        sequencia = SEQUENCIA_PARADA;
+    }
+}
+
+// Desliga o projeto: a captura para na hora; a animacao segue na tarefa "sequencia"
+void desligar_projeto() {
+    nucleo_dsp_ligar(false); // Interrompe a captura do microfone
+    energia_captura(false);
+    calibracao_cancelar();
+
+    projeto_ligado = false;
+    printf("\n[PROJECT] Projeto desligado!\n");
+    sequencia_passo = 0;
+    exibir_tela_desligar(sequencia_passo); // Exibe a tela de desligamento
+    sequencia_ir(SEQUENCIA_DESLIGANDO, DESLIGAR_PASSO_MS);
+}
+
+// Fim da animacao de desligamento: tela, LEDs e Wi-Fi
+void encerrar_projeto() {
+    limpar_tela(); // Limpa o display OLED
+    display_atualizar();
+    limpar_matriz_led(); // Apaga a matriz de LEDs
+    cyw43_arch_deinit(); // Desliga o Wi-Fi
+    wifi_connected = false;
+    energia_wifi(ENERGIA_WIFI_DESLIGADO);
+    printf("[INFO] Wi-Fi desligado.\n");
+    sequencia = SEQUENCIA_PARADA;
+}
+
+// Tarefa: um passo da ligacao ou do desligamento quando o anterior termina,
+// e o andamento da conexao ao Wi-Fi
+void tarefa_sequencia() {
+    if (sequencia == SEQUENCIA_PARADA)
+        return;
+    if (sequencia == SEQUENCIA_WIFI) {
+        wifi_conexao_t conexao = wifi_verificar_conexao();
+        if (conexao == WIFI_CONEXAO_PRONTA) {
+            sequencia = SEQUENCIA_PARADA;
+        } else if (conexao == WIFI_CONEXAO_FALHOU || time_reached(sequencia_proximo)) {
+            printf("[INFO] Nao foi possivel conectar ao Wi-Fi. O projeto continuara sem Wi-Fi.\n");
+            sequencia = SEQUENCIA_PARADA;
+        }
+        return;
+    }
+    if (!time_reached(sequencia_proximo))
+        return;
+
+    switch (sequencia) {
+    case SEQUENCIA_CARREGANDO:
+        sequencia_passo += 10;
+        if (sequencia_passo <= 100) {
+            exibir_barra_carregamento(sequencia_passo);
+            sequencia_ir(SEQUENCIA_CARREGANDO, LIGAR_PASSO_MS);
+        } else {
+            exibir_tela_pronto(); // Exibe tela de pronto
+            sequencia_ir(SEQUENCIA_PRONTO, LIGAR_PRONTO_MS);
+        }
+        break;
+    case SEQUENCIA_PRONTO:
+        iniciar_projeto();
+        break;
+    case SEQUENCIA_DESLIGANDO:
+        if (++sequencia_passo < DESLIGAR_PASSOS) {
+            exibir_tela_desligar(sequencia_passo);
+            sequencia_ir(SEQUENCIA_DESLIGANDO, DESLIGAR_PASSO_MS);
+        } else {
+            encerrar_projeto();
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Fim da calibracao: o resultado fica na tela por CALIBRACAO_RESULTADO_MS
+void calibracao_resultado(calibracao_estado_t estado) {
+    if (estado == CALIBRACAO_CONCLUIDA || estado == CALIBRACAO_FALHOU) {
+        oled_retido_ate = make_timeout_time_ms(CALIBRACAO_RESULTADO_MS);
+        medicao_oled = UINT32_MAX;  // Depois redesenha a tela normal
+    }
+}
+
+// Tarefa: gestos dos botoes, liberada pela interrupcao a cada gesto.
+// A: toque liga, segurar calibra, toque duplo alterna nivel/espectro nos LEDs.
+// B: segurar desliga, toque duplo alterna o modo de baixo consumo
+void tarefa_botoes() {
+    botao_evento_t evento;
+    while (botoes_obter_evento(&evento)) {
+        if (evento.botao == botao_a) {
+            if (evento.gesto == BOTAO_PRESSIONADO && !projeto_ligado && sequencia == SEQUENCIA_PARADA) {
+                ligar_projeto();
+            } else if (evento.gesto == BOTAO_LONGO && projeto_ligado && !calibracao_ativa() &&
+                       evento.inicio_us > projeto_ligado_us) {
+                // Calibracao com o calibrador acustico (precisa da captura rodando)
+                if (captura_pausada) {
+                    captura_pausada = false;
+                    energia_captura(true);
+                    nucleo_dsp_pausar(false);
+                }
+                calibracao_iniciar(CALIBRACAO_NIVEL_DB);  // As medicoes chegam por tarefa_medicao()
+            } else if (evento.gesto == BOTAO_DUPLO && projeto_ligado) {
+                led_modo = led_modo == LED_MODO_NIVEL ? LED_MODO_ESPECTRO : LED_MODO_NIVEL;
+                medicao_leds = UINT32_MAX;  // Redesenha a matriz no modo novo
+            }
+        } else if (evento.botao == botao_b && projeto_ligado) {
+            if (evento.gesto == BOTAO_LONGO) {
+                desligar_projeto();
+            } else if (evento.gesto == BOTAO_CURTO) {
+                oled_tela = (oled_tela + 1) % OLED_TELAS;
+                medicao_oled = UINT32_MAX;  // Desenha a tela nova inteira
+            } else if (evento.gesto == BOTAO_DUPLO) {
+                energia_set_baixo_consumo(!energia_baixo_consumo());
+                printf("[INFO] Modo de baixo consumo %s\n", energia_baixo_consumo() ? "ligado" : "desligado");
+            }
+        }
+    }
+}
+
+// Tarefa: eventos de microfonia, que chegam fora do ciclo das medicoes (alerta imediato)
+void tarefa_eventos() {
+    if (!projeto_ligado)
+        return;
+    microfonia_evento_t evento;
+    while (nucleo_dsp_obter_microfonia(&evento)) {
+        REGISTRO(REG_MICROFONIA, registro_f(evento.frequencia), registro_f(evento.destaque_ddb / 10.f),
+                 registro_f(evento.crescimento_ddb / 10.f), evento.duracao_ms);
+        microfonia_alerta_ate = make_timeout_time_ms(MICROFONIA_ALERTA_MS);
+        exibir_alerta_microfonia(evento.frequencia);
+        set_led_alerta_microfonia();
+        alerta_na_tela = true;
+        if (wifi_connected) {
+            send_feedback_to_thingspeak(evento.frequencia);
+        }
+    }
+}
+
+// Retorna true enquanto o alerta de microfonia deve ficar na tela e nos LEDs
+bool alerta_microfonia_ativo() {
+    return absolute_time_diff_us(get_absolute_time(), microfonia_alerta_ate) > 0;
+}
+
+// Tarefa: retira as medicoes do nucleo 1 (fica com a mais recente) e as exibe no console
+void tarefa_medicao() {
+    if (!projeto_ligado)
+        return;
+
+    medicao_t medicao;
+    bool nova_medicao = false;
+    while (nucleo_dsp_obter_medicao(&medicao)) {
+        grafico_historico_adicionar(&historico_db, medicao.db_tempo[oled_ponderacao_tempo]);
+        if (calibracao_ativa())
+            calibracao_resultado(calibracao_processar(&medicao));
+        nova_medicao = true;
+    }
+    if (calibracao_ativa())
+        calibracao_resultado(calibracao_processar(NULL));  // Prazo da proxima medicao
+    if (!nova_medicao)
+        return;
+    ultima_medicao = medicao;
+    medicao_valida = true;
+
+    // Baixo consumo: uma medicao por janela; o ADC para ate a proxima
+    if (energia_baixo_consumo() && !captura_pausada && !calibracao_ativa()) {
+        nucleo_dsp_pausar(true);
+        energia_captura(false);
+        captura_pausada = true;
+    }
+
+    // Cada saida usa a sua ponderacao temporal
+    current_db_level = medicao.db_tempo[envio_ponderacao_tempo]; // Atualiza a variavel global
+    const char* volume_level = classify_volume(medicao.db_tempo[oled_ponderacao_tempo]);
+
+    // Registra os valores de dB, classificacao e perdas da captura/fila (enviados depois pela USB)
+    nucleo_dsp_stats_t fila;
+    nucleo_dsp_get_stats(&fila);
+    const uint32_t freq = registro_s(ponderacao_nome(medicao.ponderacao));
+    REGISTRO(REG_DADOS_NIVEL, freq, registro_f(medicao.db), freq, registro_f(medicao.db_tempo[PONDERACAO_RAPIDA]),
+             freq, registro_f(medicao.db_tempo[PONDERACAO_LENTA]), freq,
+             registro_f(medicao.db_tempo[PONDERACAO_IMPULSO]), registro_s(volume_level));
+    REGISTRO(REG_DADOS_PICOS, registro_f(medicao.pico_ddb / 10.f), registro_f(medicao.pico_real_ddb / 10.f),
+             registro_f(medicao.pico_retido_ddb / 10.f), registro_f(medicao.fator_crista_ddb / 10.f));
+    if (medicao.saturadas_min || medicao.saturadas_max) {
+        REGISTRO(REG_AVISO_SATURACAO, medicao.saturadas_min, medicao.saturadas_max);
+    }
+    REGISTRO(REG_DADOS_FILA, medicao.blocos_perdidos, medicao.blocos_sobrescritos,
+             fila.profundidade, fila.profundidade_max, fila.descartados);
+    REGISTRO(REG_DADOS_CARGA, registro_f(medicao.carga_decimacao_pm / 10.f), registro_f(medicao.carga_dsp_pm / 10.f));
+
+    // Exibe as estatisticas de cada janela que acabou de fechar
+    static uint32_t janelas_exibidas[EST_JANELAS] = {0};
+    static const char *nomes_janelas[EST_JANELAS] = {"1 min", "15 min", "1 h"};
+    for (uint j = 0; j < EST_JANELAS; ++j) {
+        const est_resultado_t *r = &medicao.est_completa[j];
+        if (r->numero == janelas_exibidas[j]) {
+            continue;
+        }
+        janelas_exibidas[j] = r->numero;
+        if (r->numero == 0) {
+            continue;  // Estatisticas reiniciadas no nucleo 1
+        }
+        REGISTRO(REG_ESTAT, registro_s(nomes_janelas[j]), freq, registro_f(r->leq / 10.f),
+                 registro_f(r->lmax / 10.f), registro_f(r->lmin / 10.f), registro_f(r->l10 / 10.f),
+                 registro_f(r->l50 / 10.f), registro_f(r->l90 / 10.f));
+    }
+}
+
+// Tarefa: atualiza os LEDs conforme o volume captado ou o espectro (o alerta tem prioridade)
+void tarefa_leds() {
+    if (!projeto_ligado || !medicao_valida || alerta_microfonia_ativo())
+        return;  // Sem medicao ainda, ou mantem o alerta de microfonia desenhado quando o evento chegou
+    if (ultima_medicao.sequencia == medicao_leds)
+        return;
+    medicao_leds = ultima_medicao.sequencia;
+
+    uint64_t inicio = perfil_inicio();
+    if (led_modo == LED_MODO_ESPECTRO) {
+        set_led_spectrum(ultima_medicao.oitava_ddb, ESPECTRO_BANDAS_OITAVA, 300, 800);
+    } else {
+        set_led_color_based_on_volume(ultima_medicao.db_tempo[led_ponderacao_tempo]);
+    }
+    perfil_fim(PERFIL_LEDS, inicio);
+}
+
+// Tarefa: exibe as informacoes no display OLED (o alerta de microfonia tem
+// prioridade; a calibracao e o seu resultado ficam na tela ate o fim)
+void tarefa_oled() {
+    if (!projeto_ligado || !medicao_valida || alerta_microfonia_ativo())
+        return;
+    if (calibracao_ativa() || !time_reached(oled_retido_ate))
+        return;
+    if (ultima_medicao.sequencia == medicao_oled && !alerta_na_tela)
+        return;  // Nada mudou desde o ultimo desenho
+    bool tela_completa = medicao_oled == UINT32_MAX || alerta_na_tela;  // Outra tela estava no quadro
+    medicao_oled = ultima_medicao.sequencia;
+    if (alerta_na_tela) {
+        alerta_na_tela = false;
+        medicao_leds = UINT32_MAX;  // Fim do alerta: os LEDs tambem voltam ao normal
+    }
+
+    // Prepara as strings para exibicao no display OLED
+    uint64_t inicio = perfil_inicio();
+    float db_level = ultima_medicao.db_tempo[oled_ponderacao_tempo];
+    const char *freq = ponderacao_nome(ultima_medicao.ponderacao);
+    char db_str[24];
+    char volume_str[32];  // "Volume: " + a classificacao mais longa ("Extremamente Alto")
+
+    snprintf(db_str, sizeof(db_str), "L%s%s: %5.2f dB", freq, ponderacao_tempo_nome(oled_ponderacao_tempo), db_level);
+    snprintf(volume_str, sizeof(volume_str), "Volume: %s", classify_volume(db_level));
+
+    if (oled_tela == OLED_TELA_HISTORICO) {
+        exibir_tela_historico(&historico_db, db_str, db_level, tela_completa);  // So as colunas novas
+        perfil_fim(PERFIL_OLED, inicio);
+        return;
+    }
+    if (oled_tela == OLED_TELA_ESPECTRO) {
+        exibir_tela_espectro(ultima_medicao.oitava_ddb, ESPECTRO_BANDAS_OITAVA, db_str, db_level, tela_completa);
+        perfil_fim(PERFIL_OLED, inicio);
+        return;
+    }
+
+    exibir_tela_nivel(volume_str, db_str);  // Titulos fixos; so os textos alterados sao redesenhados e enviados
+    perfil_fim(PERFIL_OLED, inicio);
+}
+
+// Tarefa: mantem a conexao WiFi ativa (se houver)
+void tarefa_rede() {
+    if (projeto_ligado) {
+        uint64_t inicio = perfil_inicio();
+        cyw43_arch_poll();
+        perfil_fim(PERFIL_REDE, inicio);
+    }
+}
+
+// Tarefa: envia os dados ao ThingSpeak (se o Wi-Fi estiver conectado). No modo
+// de baixo consumo o radio so sai da economia durante cada envio
+void tarefa_envio() {
+    static absolute_time_t ultimo_envio = 0;
+    static bool radio_ativo = false;
+    if (!projeto_ligado || !wifi_connected || !medicao_valida)
+        return;
+
+    if (energia_baixo_consumo()) {
+        int64_t desde_envio_ms = absolute_time_diff_us(ultimo_envio, get_absolute_time()) / 1000;
+        if (radio_ativo && desde_envio_ms >= ENERGIA_WIFI_ATIVO_MS) {
+            wifi_set_modo_energia(ENERGIA_WIFI_MODO_ECONOMIA);
+            radio_ativo = false;
+        }
+        if (ultimo_envio != 0 && desde_envio_ms < ENERGIA_ENVIO_MS)
+            return;
+        wifi_set_modo_energia(ENERGIA_WIFI_MODO_DESEMPENHO);
+        radio_ativo = true;
+    } else if (radio_ativo) {
+        wifi_set_modo_energia(ENERGIA_WIFI_MODO_PADRAO);
+        radio_ativo = false;
+    }
+
+    uint64_t inicio = perfil_inicio();
+    send_bands_to_thingspeak(ultima_medicao.oitava_ddb);  // Vao junto com o nivel
+    send_data_to_thingspeak(current_db_level);
+    perfil_fim(PERFIL_ENVIO, inicio);
+    ultimo_envio = get_absolute_time();
+}
+
+// Tarefa: janelas de medicao do modo de baixo consumo (retoma a captura a cada
+// ENERGIA_CICLO_MS) e periodos das tarefas conforme o modo
+void tarefa_ciclo() {
+    static bool modo_aplicado = false;
+    bool baixo_consumo = energia_baixo_consumo();
+    if (baixo_consumo != modo_aplicado) {
+        modo_aplicado = baixo_consumo;
+        agendador_set_periodo(tarefa_id_eventos, baixo_consumo ? TAREFA_BAIXO_CONSUMO_MS : TAREFA_EVENTOS_MS);
+        agendador_set_periodo(tarefa_id_rede, baixo_consumo ? TAREFA_BAIXO_CONSUMO_MS : TAREFA_REDE_MS);
+        agendador_set_periodo(tarefa_id_exportacao, baixo_consumo ? TAREFA_BAIXO_CONSUMO_MS : TAREFA_EXPORTACAO_MS);
+        agendador_set_periodo(tarefa_id_registro, baixo_consumo ? TAREFA_BAIXO_CONSUMO_MS : TAREFA_REGISTRO_MS);
+        agendador_set_periodo(tarefa_id_sequencia, baixo_consumo ? TAREFA_BAIXO_CONSUMO_MS : TAREFA_SEQUENCIA_MS);
+    }
+
+    if (!projeto_ligado)
+        return;
+    if (captura_pausada && (!baixo_consumo || time_reached(proxima_janela))) {
+        proxima_janela = make_timeout_time_ms(ENERGIA_CICLO_MS);
+        captura_pausada = false;
+        energia_captura(true);
+        nucleo_dsp_pausar(false);
+    }
+}
+
+// Tarefa: envia aos poucos pela USB a gravacao congelada por um gatilho (se houver)
+void tarefa_exportacao() {
+    gravador_exportar_usb();
+}
+
+// Tarefa: envia pela USB os registros adiados dos dois nucleos
+void tarefa_registro() {
+    registro_drenar(REGISTRO_DRENAR_MAX);
+}
+
+// Tarefa: comandos digitados no console USB (uma linha por comando)
+void tarefa_comandos() {
+    static char linha[16];
+    static uint tamanho = 0;
+    int c;
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        if (c != '\r' && c != '\n') {
+            if (tamanho < sizeof(linha) - 1)
+                linha[tamanho++] = (char)c;
+            continue;
+        }
+        linha[tamanho] = '\0';
+        if (strcmp(linha, "stats") == 0) {
+            perfil_relatorio();
+            agendador_relatorio();
+            energia_relatorio();
+            botoes_relatorio();
+            registro_relatorio();
+            display_relatorio();
+        } else if (tamanho > 0) {
+            printf("[COMANDO] Desconhecido: %s (use: stats)\n", linha);
+        }
+        tamanho = 0;
+    }
+}
+
+// Tarefa: ocupacao do nucleo 0, atrasos de cada tarefa, energia estimada e latencia dos botoes
+void tarefa_relatorio() {
+    if (projeto_ligado) {
+        agendador_relatorio();
+        energia_relatorio();
+        botoes_relatorio();
+    }
+}
+
 
 
 int main() {
     stdio_init_all();  // Inicializa a comunicacao serial via USB
+    energia_init();    // Contabiliza o tempo em cada estado de energia desde o boot
+    perfil_init();     // Pinta as pilhas antes de o nucleo 1 comecar
+    registro_init();   // Filas do registro adiado
 
     // Inicializa o LED onboard
     gpio_init(LED_PIN);
@@ -28,129 +528,59 @@ int main() {
 
     // Inicializa o LED onboard
 
-    // Inicializa os botoes com pull-up interno ativado
-    gpio_init(BUTTON_A_PIN);
-    gpio_set_dir(BUTTON_A_PIN, GPIO_IN);
-    gpio_pull_up(BUTTON_A_PIN);
-
-    gpio_init(BUTTON_B_PIN);
-    gpio_set_dir(BUTTON_B_PIN, GPIO_IN);
-    gpio_pull_up(BUTTON_B_PIN);
+    // Inicializa os botoes com pull-up interno e interrupcao nas bordas
+    botao_a = botoes_adicionar(BUTTON_A_PIN, CALIBRACAO_SEGURAR_MS);
+    botao_b = botoes_adicionar(BUTTON_B_PIN, DESLIGAR_SEGURAR_MS);
 
     // Inicializa a matriz de LEDs NeoPixel
     npInit(NEOPIXEL_PIN, LED_COUNT);
     
-    // Inicializa o microfone
-    microphone_init();
+    // Carrega a configuracao da flash antes de o nucleo 1 comecar a medir
+    config_init();
+    calibracao_carregar();
+
+    // Coloca o nucleo 1 para cuidar do microfone (captura + DSP)
+    nucleo_dsp_iniciar();
 
     // Inicializa os modulos necessarios
     inicializa();
 
+#ifdef SOUNDMONITOR_BENCHMARK
+    // Mede o custo das rotinas de DSP enquanto o nucleo 1 ainda esta ocioso
+    benchmark_executar();
+#endif
+
+    printf("[INFO] ADC a %u Hz, decimacao por %u, audio a %u Hz (+%.1f bits efetivos)\n",
+           (unsigned)ADC_CAPTURE_RATE, (unsigned)DECIMACAO_FATOR, (unsigned)AUDIO_SAMPLE_RATE,
+           decimador_ganho_enob(DECIMACAO_FATOR));
+    printf("[INFO] Gravador: %u ms de audio em %s (%u KB), %u ms depois do gatilho\n",
+           (unsigned)(GRAVADOR_BLOCOS * 1000 / AUDIO_BLOCOS_POR_SEGUNDO), GRAVADOR_ADPCM ? "IMA-ADPCM" : "PCM",
+           GRAVADOR_KB, (unsigned)(GRAVADOR_POS_BLOCOS * 1000 / AUDIO_BLOCOS_POR_SEGUNDO));
+    if (energia_baixo_consumo())
+        printf("[INFO] Modo de baixo consumo: medicao a cada %u s, envio a cada %u s\n",
+               (unsigned)(ENERGIA_CICLO_MS / 1000), (unsigned)(ENERGIA_ENVIO_MS / 1000));
     printf("Configuracoes completas!\n");
     printf("\n----\nAguardando botao A para iniciar...\n----\n");
 
-    while (true) {
-        // Verifica se o botao A foi pressionado para ligar o projeto
-        if (!gpio_get(BUTTON_A_PIN) && !projeto_ligado) {
-            // Menu de inicializacao com barra de progresso
-            for (int i = 10; i <= 100; i += 10) {
-                exibir_barra_carregamento(i);
-                timer_milliseconds(200);  // Aguarda 200ms (0.2s)
-            }
-            exibir_tela_pronto(); // Exibe tela de pronto
-            projeto_ligado = true;
-            printf("\n[PROJECT] Projeto ligado!\n");
-
-            // Tenta conectar ao Wi-Fi 5 vezes
-            bool wifi_conectado = false;
-            
-                printf("[INFO] Tentativa de conexao ao Wi-Fi...\n");
-                if (inicializar_wifi()) {
-                    wifi_conectado = true;
-                    printf("[INFO] Wi-Fi conectado com sucesso!\n");
-                    
-                }
-                printf("[INFO] Falha na tentativa %d. Tentando novamente em 5 segundos...\n");
-                timer_seconds(5);  // Aguarda 5 segundos antes de tentar novamente
-            
-
-            if (!wifi_conectado) {
-                printf("[INFO] Nao foi possivel conectar ao Wi-Fi. O projeto continuara sem Wi-Fi.\n");
-            }
-        }
-
-        // Verifica se o botao B foi pressionado para desligar o projeto
-        if (!gpio_get(BUTTON_B_PIN) && projeto_ligado) {
-            exibir_tela_desligar(); // Exibe a tela de desligamento
-            
-            projeto_ligado = false;
-            printf("\n[PROJECT] Projeto desligado!\n");
-            limpar_tela(); // Limpa o display OLED
-            print_texto(" ", 1, 5, 2);
-            print_texto(" ", 20, 20, 2);
-            print_texto(" ", 5, 40, 1); 
-            print_texto(" ", 5, 50, 1);
-            limpar_matriz_led(); // Apaga a matriz de LEDs
-            cyw43_arch_deinit(); // Desliga o Wi-Fi
-            printf("[INFO] Wi-Fi desligado.\n");
-        }
-
-        // Se o projeto estiver ligado, executa o loop principal
-        if (projeto_ligado) {
-            cyw43_arch_poll();  // Mantem a conexao WiFi ativa (se houver)
-
-            // Captura uma amostra do microfone e calcula a potencia media
-            sample_mic();
-            float avg = mic_power();
-            avg = 2.f * fabsf(ADC_ADJUST(avg));
-
-            // Aplica um filtro de media movel para suavizar as leituras
-            float filtered_avg = apply_moving_average_filter(avg);
-
-            // Converte a potencia filtrada para nivel de dB
-            float db_level = calculate_db(filtered_avg);
-            current_db_level = db_level; // Atualiza a variavel global
-
-            // Classifica o volume baseado no nivel de dB
-            const char* volume_level = classify_volume(db_level);
-
-            // Atualiza os LEDs conforme o volume captado
-            set_led_color_based_on_volume(db_level);
-
-            // Exibe os valores de dB e classificacao no console
-            printf("[DADOS] dB: %5.2f, Volume: %s\n\n", db_level, volume_level);
-
-            // Prepara as strings para exibicao no display OLED
-            char db_str[16];
-            char volume_str[20]; 
-            char *titulo1_str = "SOUND";
-            char *titulo2_str = "MONITOR";
-
-            sprintf(db_str, "dB: %5.2f", db_level);
-            sprintf(volume_str, "Volume: %s", volume_level);
-
-            // Exibe as informacoes no display OLED
-            limpar_tela();
-            print_texto(titulo1_str, 1, 5, 2);
-            print_texto(titulo2_str, 20, 20, 2);
-            print_texto(volume_str, 5, 40, 1);
-            print_texto(db_str, 5, 50, 1);
-            
-            // Temporizador: Envia os dados ao ThingSpeak a cada 10 segundos (se o Wi-Fi estiver conectado)
-            static absolute_time_t last_send_time = 0;
-            if (wifi_connected && absolute_time_diff_us(last_send_time, get_absolute_time()) > 1000000) {
-                send_data_to_thingspeak(db_level);
-                last_send_time = get_absolute_time();
-            }
+    // Cada atividade roda no seu ritmo; entre elas o nucleo 0 dorme
+    botoes_set_tarefa(agendador_adicionar("botoes", TAREFA_BOTOES_MS, tarefa_botoes));
+    tarefa_id_sequencia = agendador_adicionar("sequencia", TAREFA_SEQUENCIA_MS, tarefa_sequencia);
+    tarefa_id_eventos = agendador_adicionar("eventos", TAREFA_EVENTOS_MS, tarefa_eventos);
+    agendador_adicionar("medicao", TAREFA_MEDICAO_MS, tarefa_medicao);
+    agendador_adicionar("leds", TAREFA_LEDS_MS, tarefa_leds);
+    agendador_adicionar("oled", TAREFA_OLED_MS, tarefa_oled);
+    tarefa_id_rede = agendador_adicionar("rede", TAREFA_REDE_MS, tarefa_rede);
+    agendador_adicionar("envio", TAREFA_ENVIO_MS, tarefa_envio);
+    tarefa_id_exportacao = agendador_adicionar("exportacao", TAREFA_EXPORTACAO_MS, tarefa_exportacao);
+    agendador_adicionar("relatorio", TAREFA_RELATORIO_MS, tarefa_relatorio);
+    agendador_adicionar("ciclo", TAREFA_CICLO_MS, tarefa_ciclo);
+    agendador_adicionar("comandos", TAREFA_COMANDOS_MS, tarefa_comandos);
+    tarefa_id_registro = agendador_adicionar("registro", TAREFA_REGISTRO_MS, tarefa_registro);
 
-            // Aguarda 1 segundo antes da proxima leitura
-            timer_seconds(1);
-        } else {
-            // Se o projeto estiver desligado, aguarda um pouco antes de verificar novamente os botoes
-            timer_milliseconds(100);
-        }
-    }
+    // Esperas longas entre tarefas baixam o clock no modo de baixo consumo
+    agendador_set_ocioso(ENERGIA_OCIOSO_MIN_US, energia_ocioso);
+    agendador_executar();  // Nao retorna
 
     cyw43_arch_deinit();  // Desliga o WiFi ao finalizar
     return 0;
-}
\ No newline at end of file
+}
@@ -1,11 +1,124 @@
 #include "lib/microfone.h"  // Inclui o cabeçalho com definições e constantes específicas do microfone
+#include "lib/decimador.h"  // Da taxa do ADC para a taxa de áudio
+#include "lib/decibel.h"    // dB em ponto fixo
+
+#include "hardware/irq.h"   // Interrupção de fim de transferência do DMA
+#include "hardware/sync.h"  // Seções críticas entre a interrupção e o consumidor
+#include <string.h>
 
 // Variáveis globais
-uint dma_channel;                     // Canal DMA usado para transferir dados do ADC
-dma_channel_config dma_cfg;           // Configuração do canal DMA
-uint16_t adc_buffer[SAMPLES];         // Buffer para armazenar as amostras do ADC
-float filter_buffer[FILTER_SIZE] = {0}; // Buffer para o filtro de média móvel
-uint filter_index = 0;                // Índice atual do buffer do filtro
+uint dma_channel[2];                  // Canais DMA encadeados (ping-pong) que transferem dados do ADC
+dma_channel_config dma_cfg[2];        // Configuração de cada canal DMA
+uint16_t adc_buffer[2][ADC_SAMPLES_BLOCO];  // Buffers alternados das amostras do ADC (taxa do ADC)
+
+// Estado da captura contínua (atualizado pela interrupção do DMA)
+static volatile int bloco_pronto = -1;   // Bloco completo aguardando o consumidor (-1 = nenhum)
+static volatile int bloco_em_uso = -1;   // Bloco que o consumidor está processando (-1 = nenhum)
+static volatile mic_capture_stats_t capture_stats;
+
+// Decimador da captura contínua (estado mantido entre blocos)
+static decimador_t decimador;
+
+// Calibração e limiares em uso, escritos pelo núcleo 0 e lidos no núcleo 1
+// (palavras de 32 bits: leitura e escrita atômicas)
+static volatile int32_t calibracao_ganho_mdb = 0;
+static volatile int32_t calibracao_bias = ADC_BIAS_CODE << AUDIO_FRAC_BITS;
+static int32_t bias_aplicado = ADC_BIAS_CODE << AUDIO_FRAC_BITS;
+static int16_t limiares_ddb[MIC_LIMIARES] = MIC_LIMIARES_PADRAO;
+
+// Linearização: valor de cada código (AUDIO_FRAC_BITS bits fracionários),
+// em RAM para não depender do cache da flash no laço do CIC
+static uint16_t linearizacao[ADC_CODIGO_MAX + 1];
+static int16_t dnl_larguras_q4[ADC_DNL_PONTOS] = {
+    ADC_DNL_LARGURA_Q4, ADC_DNL_LARGURA_Q4, ADC_DNL_LARGURA_Q4, ADC_DNL_LARGURA_Q4
+};
+
+// Correções pedidas pelo núcleo 0 e as aplicadas no núcleo 1
+static volatile bool linearizar_solicitado = MIC_LINEARIZAR_PADRAO;
+static volatile bool remover_dc_solicitado = MIC_REMOVER_DC_PADRAO;
+static bool linearizacao_aplicada = false;
+
+// Passa-altas que acompanha o DC: dc = acumulador >> dc_desloca
+static int32_t dc_acumulador = 0;
+static uint32_t dc_desloca;
+
+// Interpolador do true peak: coeficientes das fases 1..3 (Q14) e as últimas
+// TRUE_PEAK_TAPS - 1 amostras do bloco anterior seguidas do bloco atual
+static int32_t true_peak_coef[TRUE_PEAK_FATOR - 1][TRUE_PEAK_TAPS];
+static int32_t true_peak_janela[TRUE_PEAK_TAPS - 1 + SAMPLES];
+
+/**
+ * Interrupção do DMA: marca o bloco recém-preenchido como pronto e
+ * rearma o canal que terminou para a próxima volta do ping-pong.
+ */
+static void mic_dma_irq_handler() {
+    for (int i = 0; i < 2; ++i) {
+        if (!dma_channel_get_irq0_status(dma_channel[i]))
+            continue;
+        dma_channel_acknowledge_irq0(dma_channel[i]);
+
+        // O contador de transferências é recarregado sozinho; só o endereço de escrita precisa voltar ao início
+        dma_channel_set_write_addr(dma_channel[i], adc_buffer[i], false);
+
+        // O canal encadeado já está escrevendo no outro buffer
+        if (bloco_em_uso == 1 - i)
+            capture_stats.blocks_overrun++;   // O consumidor ainda estava lendo esse buffer
+        if (bloco_pronto != -1)
+            capture_stats.blocks_dropped++;   // O bloco anterior nunca foi retirado
+
+        bloco_pronto = i;
+        capture_stats.blocks_captured++;
+    }
+}
+
+/**
+ * Calcula as fases do interpolador 4x do true peak: sinc janelado (Hann)
+ * em t = m - p/4, com m = -5..6 em torno do par de amostras, normalizado
+ * para ganho 1 em DC.
+ */
+static void true_peak_init() {
+    for (int p = 1; p < TRUE_PEAK_FATOR; ++p) {
+        float h[TRUE_PEAK_TAPS], soma = 0.f;
+        for (int m = 0; m < TRUE_PEAK_TAPS; ++m) {
+            float t = (m - (TRUE_PEAK_TAPS / 2 - 1)) - (float)p / TRUE_PEAK_FATOR;
+            float sinc = sinf((float)M_PI * t) / ((float)M_PI * t);
+            float janela = 0.5f * (1.f + cosf((float)M_PI * t / (TRUE_PEAK_TAPS / 2 + 1)));
+            h[m] = sinc * janela;
+            soma += h[m];
+        }
+        for (int m = 0; m < TRUE_PEAK_TAPS; ++m)
+            true_peak_coef[p - 1][m] = (int32_t)lroundf(h[m] / soma * 16384.f);
+    }
+}
+
+/**
+ * Monta a tabela de linearização: cada código com DNL vale o centro do seu
+ * intervalo real (mais largo), os seguintes são deslocados pelo excesso, e
+ * tudo é reescalado para a faixa de ADC_CODIGO_MAX + 1 códigos. Sem DNL, o
+ * valor do código c é exatamente c << AUDIO_FRAC_BITS.
+ */
+static void linearizacao_init() {
+    static const uint16_t codigos[ADC_DNL_PONTOS] = ADC_DNL_CODIGOS;
+    const int32_t um = 1 << AUDIO_FRAC_BITS;  // 1 LSB em Q4
+
+    int64_t total = (int64_t)(ADC_CODIGO_MAX + 1) * um;
+    for (uint k = 0; k < ADC_DNL_PONTOS; ++k)
+        total += dnl_larguras_q4[k];
+
+    int64_t inicio = 0;  // Início do intervalo do código na escala real (Q4)
+    uint k = 0;
+    for (uint32_t c = 0; c <= ADC_CODIGO_MAX; ++c) {
+        int32_t largura = um;
+        if (k < ADC_DNL_PONTOS && c == codigos[k])
+            largura += dnl_larguras_q4[k++];
+
+        // Centro do intervalo reescalado, menos meio LSB (o código ideal c fica em c)
+        int64_t centro = (2 * inicio + largura) * (int64_t)(ADC_CODIGO_MAX + 1) * um;
+        int64_t valor = (centro + total) / (2 * total) - um / 2;
+        linearizacao[c] = (uint16_t)(valor < 0 ? 0 : valor > UINT16_MAX ? UINT16_MAX : valor);
+        inicio += largura;
+    }
+}
 
 /**
  * Inicializa o microfone e o ADC.
@@ -27,91 +140,335 @@ void microphone_init() {
 
     adc_set_clkdiv(ADC_CLOCK_DIV);    // Configura o divisor de clock do ADC
 
-    // Configuração do DMA
-    dma_channel = dma_claim_unused_channel(true);  // Obtém um canal DMA livre
-    dma_cfg = dma_channel_get_default_config(dma_channel);  // Obtém a configuração padrão do DMA
-    channel_config_set_transfer_data_size(&dma_cfg, DMA_SIZE_16);  // Define o tamanho dos dados como 16 bits
-    channel_config_set_read_increment(&dma_cfg, false);  // Não incrementar o endereço de leitura (lê sempre do FIFO do ADC)
-    channel_config_set_write_increment(&dma_cfg, true);   // Incrementar o endereço de escrita (escreve no buffer)
-    channel_config_set_dreq(&dma_cfg, DREQ_ADC);         // Usa o ADC como fonte de dados para o DMA
+    // Configuração dos dois canais DMA: cada um preenche seu buffer e dispara o outro ao terminar
+    dma_channel[0] = dma_claim_unused_channel(true);  // Obtém os canais DMA livres
+    dma_channel[1] = dma_claim_unused_channel(true);
+    for (int i = 0; i < 2; ++i) {
+        dma_cfg[i] = dma_channel_get_default_config(dma_channel[i]);  // Obtém a configuração padrão do DMA
+        channel_config_set_transfer_data_size(&dma_cfg[i], DMA_SIZE_16);  // Define o tamanho dos dados como 16 bits
+        channel_config_set_read_increment(&dma_cfg[i], false);  // Não incrementar o endereço de leitura (lê sempre do FIFO do ADC)
+        channel_config_set_write_increment(&dma_cfg[i], true);   // Incrementar o endereço de escrita (escreve no buffer)
+        channel_config_set_dreq(&dma_cfg[i], DREQ_ADC);         // Usa o ADC como fonte de dados para o DMA
+        channel_config_set_chain_to(&dma_cfg[i], dma_channel[1 - i]);  // Ao terminar, inicia o outro canal
+        dma_channel_set_irq0_enabled(dma_channel[i], true);     // Gera interrupção a cada bloco completo
+    }
+
+    irq_set_exclusive_handler(DMA_IRQ_0, mic_dma_irq_handler);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    decimador_init(&decimador, DECIMACAO_FATOR);
+    linearizacao_init();
+    dc_desloca = (uint32_t)lroundf(log2f(AUDIO_SAMPLE_RATE / (2.f * (float)M_PI * MIC_DC_CORTE_HZ)));
+    true_peak_init();
 }
 
 /**
- * Realiza as leituras do ADC e armazena os valores no buffer.
+ * Inicia a captura contínua: os canais DMA se alternam indefinidamente
+ * entre os dois buffers sem intervenção da CPU.
  */
-void sample_mic() {
-    adc_fifo_drain();  // Limpa o FIFO do ADC para evitar dados antigos
+void mic_capture_start() {
     adc_run(false);    // Desliga o ADC (se estiver ligado) para configurar o DMA
+    adc_fifo_drain();  // Limpa o FIFO do ADC para evitar dados antigos
 
-    // Configura o DMA para transferir dados do FIFO do ADC para o buffer
-    dma_channel_configure(dma_channel, &dma_cfg,
-        adc_buffer,    // Escreve no buffer de amostras
-        &(adc_hw->fifo), // Lê do FIFO do ADC
-        SAMPLES,       // Número de amostras a serem coletadas
-        true           // Inicia o DMA imediatamente
-    );
+    bloco_pronto = -1;
+    bloco_em_uso = -1;
+    bias_aplicado = calibracao_bias;
+    linearizacao_aplicada = linearizar_solicitado;
+    decimador_set_bias(&decimador, bias_aplicado);
+    decimador_set_linearizacao(&decimador, linearizacao_aplicada ? linearizacao : NULL);
+    // dc_acumulador continua: o DC da entrada não muda entre capturas e a
+    // retomada (modo de baixo consumo) não espera o passa-altas convergir
+    memset(true_peak_janela, 0, sizeof(true_peak_janela));
+
+    for (int i = 0; i < 2; ++i) {
+        dma_channel_configure(dma_channel[i], &dma_cfg[i],
+            adc_buffer[i],     // Escreve no buffer deste canal
+            &(adc_hw->fifo),   // Lê do FIFO do ADC
+            ADC_SAMPLES_BLOCO, // Número de amostras por bloco
+            false              // O canal 1 só começa quando o canal 0 terminar
+        );
+    }
 
-    // Liga o ADC e espera o DMA terminar a transferência
+    dma_channel_start(dma_channel[0]);
     adc_run(true);
-    dma_channel_wait_for_finish_blocking(dma_channel);
+}
 
-    // Desliga o ADC após a leitura
+/**
+ * Interrompe a captura contínua e desliga o ADC.
+ */
+void mic_capture_stop() {
     adc_run(false);
+
+    // Remove o encadeamento antes de abortar, senão o abort pode disparar o outro canal (errata RP2040-E13)
+    for (int i = 0; i < 2; ++i) {
+        dma_channel_config cfg = dma_cfg[i];
+        channel_config_set_chain_to(&cfg, dma_channel[i]);
+        dma_channel_set_config(dma_channel[i], &cfg, false);
+    }
+    for (int i = 0; i < 2; ++i) {
+        dma_channel_abort(dma_channel[i]);
+        dma_channel_acknowledge_irq0(dma_channel[i]);
+    }
+
+    adc_fifo_drain();
+    bloco_pronto = -1;
+    bloco_em_uso = -1;
 }
 
 /**
- * Calcula a potência média das leituras do ADC (valor RMS).
+ * Retira o bloco completo mais recente, se houver. Não bloqueia.
+ * O bloco deve ser devolvido com mic_capture_release() antes que o
+ * DMA volte a escrever nele (1 / AUDIO_BLOCOS_POR_SEGUNDO segundos).
  */
-float mic_power() {
-    float avg = 0.f;
+const uint16_t* mic_capture_acquire() {
+    uint32_t status = save_and_disable_interrupts();
+    int bloco = bloco_pronto;
+    bloco_pronto = -1;
+    bloco_em_uso = bloco;
+    restore_interrupts(status);
 
-    // Soma os quadrados das amostras para calcular a potência
-    for (uint i = 0; i < SAMPLES; ++i)
-        avg += adc_buffer[i] * adc_buffer[i];
-    
-    avg /= SAMPLES;  // Calcula a média
-    return sqrt(avg); // Retorna a raiz quadrada (valor RMS)
+    return bloco < 0 ? NULL : adc_buffer[bloco];
 }
 
 /**
- * Aplica um filtro de média móvel para suavizar as leituras.
+ * Devolve o bloco obtido por mic_capture_acquire().
  */
-float apply_moving_average_filter(float new_value) {
-    filter_buffer[filter_index] = new_value;  // Adiciona o novo valor ao buffer do filtro
-    filter_index = (filter_index + 1) % FILTER_SIZE;  // Atualiza o índice do buffer (circular)
+void mic_capture_release() {
+    bloco_em_uso = -1;
+}
 
-    // Calcula a média dos valores no buffer
-    float sum = 0.f;
-    for (uint i = 0; i < FILTER_SIZE; ++i) {
-        sum += filter_buffer[i];
+/**
+ * Copia os contadores da captura contínua.
+ */
+void mic_capture_get_stats(mic_capture_stats_t *stats) {
+    uint32_t status = save_and_disable_interrupts();
+    *stats = capture_stats;
+    restore_interrupts(status);
+}
+
+/**
+ * Converte um bloco do ADC para o formato interno de áudio: remove o bias
+ * e guarda em int32_t com AUDIO_FRAC_BITS bits fracionários, para que os
+ * filtros seguintes não percam resolução.
+ */
+void mic_convert_block(const uint16_t *buffer, int32_t *amostras, uint n) {
+    for (uint i = 0; i < n; ++i)
+        amostras[i] = ((int32_t)buffer[i] - ADC_BIAS_CODE) << AUDIO_FRAC_BITS;
+}
+
+/**
+ * Energia, pico e soma de um bloco decimado, removendo (no lugar) o DC
+ * acompanhado se remover_dc e copiando o resultado, saturado em 16 bits,
+ * para gravacao se ele não for NULL. Expandida em cada chamada, como
+ * cic_integrar.
+ */
+static inline __attribute__((always_inline))
+void analisar_amostras(int32_t *amostras, uint n, bool remover_dc, int16_t *gravacao, mic_bloco_info_t *info) {
+    uint64_t energia = 0;
+    int32_t maximo = 0, minimo = 0, soma = 0;
+    int32_t acumulador = dc_acumulador;
+
+    for (uint i = 0; i < n; ++i) {
+        int32_t x = amostras[i];
+        soma += x;
+        if (remover_dc) {
+            int32_t dc = acumulador >> dc_desloca;
+            acumulador += x - dc;
+            x -= dc;
+            amostras[i] = x;
+        }
+        if (gravacao != NULL)
+            gravacao[i] = (int16_t)(x > INT16_MAX ? INT16_MAX : x < INT16_MIN ? INT16_MIN : x);
+        energia += (uint32_t)x * (uint32_t)x;
+        if (x > maximo)
+            maximo = x;
+        else if (x < minimo)
+            minimo = x;
+    }
+
+    dc_acumulador = acumulador;
+    info->energia = energia;
+    info->pico = maximo > -minimo ? maximo : -minimo;
+    info->soma = soma;
+}
+
+/**
+ * Decima n códigos do ADC para o formato interno de áudio e mede, sobre o
+ * áudio decimado, a energia sem ponderação e o pico de amostra; as amostras
+ * saturadas (códigos 0 e ADC_CODIGO_MAX) são contadas na entrada, na mesma
+ * passada do CIC, que também aplica a linearização. A remoção do DC e a
+ * cópia em 16 bits para gravacao (opcional: o anel do gravador) acompanham
+ * a passada da energia. É a única leitura do adc_buffer.
+ * Retorna quantas amostras de áudio foram escritas (SAMPLES para um bloco
+ * do DMA).
+ */
+uint mic_analisar_bloco(const uint16_t *buffer, uint n, int32_t *amostras, int16_t *gravacao,
+                        mic_bloco_info_t *info) {
+    if (calibracao_bias != bias_aplicado) {
+        bias_aplicado = calibracao_bias;
+        decimador_set_bias(&decimador, bias_aplicado);
+    }
+    if (linearizar_solicitado != linearizacao_aplicada) {
+        linearizacao_aplicada = linearizar_solicitado;
+        decimador_set_linearizacao(&decimador, linearizacao_aplicada ? linearizacao : NULL);
+    }
+
+    uint32_t saturadas_min = 0, saturadas_max = 0;
+    uint saida = decimador_processar(&decimador, buffer, n, amostras, &saturadas_min, &saturadas_max);
+
+    if (remover_dc_solicitado)
+        analisar_amostras(amostras, saida, true, gravacao, info);
+    else
+        analisar_amostras(amostras, saida, false, gravacao, info);
+    info->saturadas_min = saturadas_min;
+    info->saturadas_max = saturadas_max;
+
+    capture_stats.samples_clipped_low += saturadas_min;
+    capture_stats.samples_clipped_high += saturadas_max;
+    return saida;
+}
+
+/**
+ * True peak (sobreamostragem 4x) de um bloco já convertido, continuando o
+ * fluxo do bloco anterior (a saída fica atrasada TRUE_PEAK_TAPS / 2 amostras).
+ *
+ * Só interpola entre pares de amostras a menos de 6 dB do pico de amostra
+ * do bloco: um sinal de áudio real não passa tanto do valor das amostras
+ * vizinhas entre elas, e isso deixa o custo perto do de um pico simples.
+ * Retorna o maior entre o pico de amostra e os valores interpolados.
+ */
+int32_t mic_true_peak(const int32_t *amostras, uint n, int32_t pico) {
+    const uint historico = TRUE_PEAK_TAPS - 1;
+    int32_t *janela = true_peak_janela;
+    memcpy(&janela[historico], amostras, n * sizeof(int32_t));
+
+    const int32_t limiar = pico >> 1;
+    int32_t pico_real = pico;
+
+    // Intervalo entre janela[j] e janela[j + 1], usando janela[j - 5 .. j + 6]
+    for (uint j = TRUE_PEAK_TAPS / 2 - 1; j < n + TRUE_PEAK_TAPS / 2 - 1; ++j) {
+        int32_t a = janela[j] < 0 ? -janela[j] : janela[j];
+        int32_t b = janela[j + 1] < 0 ? -janela[j + 1] : janela[j + 1];
+        if (a < limiar && b < limiar)
+            continue;
+
+        const int32_t *x = &janela[j - (TRUE_PEAK_TAPS / 2 - 1)];
+        for (uint p = 0; p < TRUE_PEAK_FATOR - 1; ++p) {
+            const int32_t *h = true_peak_coef[p];
+            int32_t soma = 0;
+            for (uint m = 0; m < TRUE_PEAK_TAPS; ++m)
+                soma += x[m] * h[m];
+            soma = (soma + (1 << 13)) >> 14;
+            if (soma < 0)
+                soma = -soma;
+            if (soma > pico_real)
+                pico_real = soma;
+        }
+    }
+
+    // Guarda o fim do bloco para o próximo
+    memmove(janela, &janela[n], historico * sizeof(int32_t));
+    return pico_real;
+}
+
+/**
+ * Soma dos quadrados de um bloco já no formato interno (após ponderação).
+ * Cada quadrado cabe em 32 bits sem sinal enquanto |amostra| < 2^16
+ * (o produto sem sinal dá o quadrado correto também para negativos).
+ */
+uint64_t mic_energy_samples(const int32_t *amostras, uint n) {
+    uint64_t energia = 0;
+    const int32_t *p = amostras;
+    const int32_t *fim4 = amostras + (n & ~3u);
+
+    while (p < fim4) {
+        energia += (uint32_t)p[0] * (uint32_t)p[0];
+        energia += (uint32_t)p[1] * (uint32_t)p[1];
+        energia += (uint32_t)p[2] * (uint32_t)p[2];
+        energia += (uint32_t)p[3] * (uint32_t)p[3];
+        p += 4;
     }
-    return sum / FILTER_SIZE;  // Retorna a média
+    for (; p < amostras + n; ++p)
+        energia += (uint32_t)*p * (uint32_t)*p;
+    return energia;
 }
 
 /**
- * Calcula o nível de dB a partir da tensão.
+ * Aplica uma calibração: o ganho vale para o próximo nível calculado e o
+ * bias para o próximo bloco decimado.
+ */
+void mic_set_calibracao(const mic_calibracao_t *calibracao) {
+    calibracao_ganho_mdb = calibracao->ganho_mdb;
+    calibracao_bias = calibracao->bias;
+}
+
+/**
+ * Copia a calibração em uso.
+ */
+void mic_get_calibracao(mic_calibracao_t *calibracao) {
+    calibracao->ganho_mdb = calibracao_ganho_mdb;
+    calibracao->bias = calibracao_bias;
+}
+
+/**
+ * Define os limiares (0,1 dB, crescentes) usados por classify_volume().
+ * Só o núcleo 0 classifica o volume.
+ */
+void mic_set_limiares(const int16_t *limiares) {
+    memcpy(limiares_ddb, limiares, sizeof(limiares_ddb));
+}
+
+/**
+ * Define a largura extra (LSB com AUDIO_FRAC_BITS bits fracionários) de
+ * cada código de ADC_DNL_CODIGOS, medida na placa. Vale a partir de
+ * microphone_init(): deve ser chamada antes de nucleo_dsp_iniciar().
+ */
+void mic_set_dnl(const int16_t *larguras_q4) {
+    memcpy(dnl_larguras_q4, larguras_q4, sizeof(dnl_larguras_q4));
+}
+
+/**
+ * Liga ou desliga a linearização dos códigos e a remoção adaptativa do DC.
+ * Aplicadas no próximo bloco; trocar a linearização reinicia o decimador.
+ */
+void mic_set_correcoes(bool linearizar, bool remover_dc) {
+    linearizar_solicitado = linearizar;
+    remover_dc_solicitado = remover_dc;
+}
+
+/**
+ * Calcula o nível de dB a partir da tensão, com o ganho da calibração.
+ * O log vem dos bits do float (log2_q16_float), sem log10f.
  */
 float calculate_db(float voltage) {
-    float reference_voltage = 0.0001f;  // Tensão de referência para 0 dB (ajuste conforme necessário)
-    float db = 20.0f * log10f(voltage / reference_voltage);  // Calcula o nível de dB
-    return db;
+    // 20 * log10(V / 0,0001 V): 0 dB em 0,1 mV
+    int32_t mdb = log2_q16_para_mdb(log2_q16_float(voltage));
+    if (mdb == DECIBEL_MDB_ZERO)
+        return -INFINITY;
+    return (2 * mdb + MIC_REFERENCIA_TENSAO_MDB + calibracao_ganho_mdb) / 1000.f;
+}
+
+/**
+ * Nível em milésimos de dB de uma média quadrática no formato interno,
+ * com o ganho da calibração; equivale a calculate_db() da tensão RMS, só
+ * com aritmética inteira. Retorna DECIBEL_MDB_ZERO para media = 0.
+ */
+int32_t mic_media_quadratica_para_mdb(uint64_t media) {
+    int32_t mdb = potencia_para_mdb(media);
+    if (mdb == DECIBEL_MDB_ZERO)
+        return mdb;
+    return mdb + MIC_REFERENCIA_MEDIA_MDB + calibracao_ganho_mdb;
 }
 
 /**
  * Classifica o volume com base no nível de dB.
  */
 const char* classify_volume(float db) {
-    if (db < 30) {
-        return "Muito Baixo";
-    } else if (db < 43) {
-        return "Baixo";
-    } else if (db < 55) {
-        return "Moderado";
-    } else if (db < 60) {
-        return "Alto";
-    } else if (db < 90) {
-        return "Muito Alto";
-    } else {
-        return "Extremamente Alto";
-    }
-}
\ No newline at end of file
+    static const char *nomes[MIC_LIMIARES + 1] = {
+        "Muito Baixo", "Baixo", "Moderado", "Alto", "Muito Alto", "Extremamente Alto"
+    };
+    uint faixa = 0;
+    while (faixa < MIC_LIMIARES && db * 10.f >= limiares_ddb[faixa])
+        faixa++;
+    return nomes[faixa];
+}
@@ -0,0 +1,181 @@
+#include "lib/microfonia.h"  // Detector de microfonia sobre o espectro
+#include <string.h>
+
+// Fator de conversão de log2 em Q8 para décimos de dB: 10 * log10(2) * 10 / 256, em Q16
+#define LOG2_Q8_PARA_DDB_Q16 7706
+
+/**
+ * log2 aproximado em Q8: parte inteira exata, fração linear entre potências
+ * de 2 (erro máximo de 0,09, ou 0,26 dB). log2_q8(0) = 0.
+ */
+static int32_t log2_q8(uint32_t x) {
+    if (x == 0)
+        return 0;
+    int32_t e = 31 - __builtin_clz(x);
+    return (e << 8) | (((x << (31 - e)) >> 23) & 0xFF);
+}
+
+static int16_t log2_q8_para_ddb(int32_t v) {
+    return (int16_t)((v * LOG2_Q8_PARA_DDB_Q16) / 65536);
+}
+
+/**
+ * Prepara o detector para a taxa de amostragem dada.
+ */
+void microfonia_init(microfonia_t *m, uint32_t taxa_amostragem) {
+    m->resolucao = (float)taxa_amostragem / ESPECTRO_N;
+    m->ms_por_quadro = 1000.f * ESPECTRO_N / taxa_amostragem;
+
+    // Faixa de bins, deixando 3 de margem para a comparação com os vizinhos
+    uint32_t k_min = (uint32_t)(MICROFONIA_F_MIN / m->resolucao + 0.5f);
+    uint32_t k_max = (uint32_t)(MICROFONIA_F_MAX / m->resolucao + 0.5f);
+    if (k_min < 3)
+        k_min = 3;
+    if (k_max > ESPECTRO_N / 2 - 4)
+        k_max = ESPECTRO_N / 2 - 4;
+    m->k_min = k_min;
+    m->k_max = k_max;
+
+    uint32_t quadros = (uint32_t)(MICROFONIA_PERSISTENCIA_MS / m->ms_por_quadro + 0.999f);
+    m->quadros_min = quadros < 3 ? 3 : quadros;
+    m->destaque_q8 = MICROFONIA_DESTAQUE_DDB * 65536 / LOG2_Q8_PARA_DDB_Q16;
+    m->queda_q8 = MICROFONIA_QUEDA_DDB * 65536 / LOG2_Q8_PARA_DDB_Q16;
+    m->salto_q8 = MICROFONIA_SALTO_DDB * 65536 / LOG2_Q8_PARA_DDB_Q16;
+
+    microfonia_reiniciar(m);
+}
+
+/**
+ * Esquece todos os picos acompanhados.
+ */
+void microfonia_reiniciar(microfonia_t *m) {
+    memset(m->candidatos, 0, sizeof(m->candidatos));
+}
+
+/**
+ * Começa a acompanhar um pico a partir do quadro atual.
+ */
+static void candidato_iniciar(microfonia_candidato_t *cand, uint k, int32_t nivel) {
+    cand->bin = k;
+    cand->quadros = 1;
+    cand->quedas = 0;
+    cand->alarmado = false;
+    cand->nivel_ini = cand->nivel = nivel;
+}
+
+/**
+ * Frequência do pico no bin k, por interpolação parabólica dos níveis em log.
+ */
+static float microfonia_frequencia(const microfonia_t *m, const uint32_t *potencia, uint k) {
+    int32_t a = log2_q8(potencia[k - 1]), b = log2_q8(potencia[k]), c = log2_q8(potencia[k + 1]);
+    int32_t denominador = a - 2 * b + c;
+    float delta = denominador != 0 ? 0.5f * (a - c) / denominador : 0.f;
+    return (k + delta) * m->resolucao;
+}
+
+/**
+ * Analisa um quadro do espectro de potência (|X[k]|^2 na escala
+ * 2^(2 * expoente), como deixado por espectro_adicionar).
+ *
+ * Um pico é candidato quando se destaca da média logarítmica do quadro e dos bins
+ * vizinhos; vira microfonia quando persiste por MICROFONIA_PERSISTENCIA_MS
+ * crescendo pelo menos MICROFONIA_CRESCIMENTO_DDB, com quedas em no máximo
+ * 1/4 dos quadros. Cada pico gera um único evento enquanto persistir.
+ *
+ * Preenche até MICROFONIA_CANDIDATOS eventos e retorna quantos.
+ */
+uint microfonia_quadro(microfonia_t *m, const uint32_t *potencia, int32_t expoente, microfonia_evento_t *eventos) {
+    // Média logarítmica (média geométrica da potência) da faixa analisada:
+    // poucos bins fortes, inclusive o próprio pico, quase não a deslocam
+    int32_t soma_log = 0;
+    for (uint k = m->k_min; k <= m->k_max; ++k)
+        soma_log += log2_q8(potencia[k]);
+    const int32_t nivel_medio = soma_log / (int32_t)(m->k_max - m->k_min + 1);
+
+    // Picos estreitos do quadro, do mais forte para o mais fraco
+    uint16_t picos[MICROFONIA_CANDIDATOS];
+    uint n_picos = 0;
+    for (uint k = m->k_min; k <= m->k_max; ++k) {
+        uint32_t p = potencia[k];
+        if (p < potencia[k - 1] || p <= potencia[k + 1])
+            continue;
+        if (((uint64_t)potencia[k - 3] << MICROFONIA_VIZINHOS_LOG2) >= p ||
+            ((uint64_t)potencia[k + 3] << MICROFONIA_VIZINHOS_LOG2) >= p)
+            continue;
+        if (log2_q8(p) - nivel_medio < m->destaque_q8)
+            continue;
+
+        uint i = n_picos < MICROFONIA_CANDIDATOS ? n_picos++ : MICROFONIA_CANDIDATOS;
+        while (i > 0 && potencia[picos[i - 1]] < p) {
+            if (i < MICROFONIA_CANDIDATOS)
+                picos[i] = picos[i - 1];
+            --i;
+        }
+        if (i < MICROFONIA_CANDIDATOS)
+            picos[i] = k;
+    }
+
+    bool usado[MICROFONIA_CANDIDATOS] = {false};
+    uint n_eventos = 0;
+
+    // Acompanha os picos já conhecidos (tolerando 1 bin de deriva)
+    for (uint c = 0; c < MICROFONIA_CANDIDATOS; ++c) {
+        microfonia_candidato_t *cand = &m->candidatos[c];
+        if (cand->bin == 0)
+            continue;
+
+        uint j = 0;
+        while (j < n_picos && (usado[j] || picos[j] + 1 < cand->bin || picos[j] > cand->bin + 1))
+            ++j;
+        if (j == n_picos) {
+            cand->bin = 0;  // Sumiu: libera a posição
+            continue;
+        }
+        usado[j] = true;
+
+        uint k = picos[j];
+        int32_t nivel = log2_q8(potencia[k]) + 512 * expoente;
+        cand->bin = k;
+        if (nivel > cand->nivel + m->salto_q8) {
+            // Ataque de uma nota nova no mesmo lugar: a microfonia não sobe tão rápido
+            candidato_iniciar(cand, k, nivel);
+            continue;
+        }
+        if (nivel < cand->nivel - m->queda_q8)
+            cand->quedas++;
+        cand->nivel = nivel;
+        if (cand->quadros < UINT16_MAX)
+            cand->quadros++;
+
+        if (cand->alarmado || cand->quadros < m->quadros_min)
+            continue;
+
+        int16_t crescimento = log2_q8_para_ddb(cand->nivel - cand->nivel_ini);
+        int16_t destaque = log2_q8_para_ddb(log2_q8(potencia[k]) - nivel_medio);
+        if (crescimento < MICROFONIA_CRESCIMENTO_DDB || cand->quedas > cand->quadros / 4)
+            continue;
+
+        cand->alarmado = true;
+        microfonia_evento_t *ev = &eventos[n_eventos++];
+        ev->tempo_ms = 0;  // Preenchido por quem publica o evento
+        ev->frequencia = microfonia_frequencia(m, potencia, k);
+        ev->destaque_ddb = destaque;
+        ev->crescimento_ddb = crescimento;
+        ev->duracao_ms = (uint16_t)(cand->quadros * m->ms_por_quadro);
+    }
+
+    // Picos novos ocupam as posições livres
+    for (uint j = 0; j < n_picos; ++j) {
+        if (usado[j])
+            continue;
+        for (uint c = 0; c < MICROFONIA_CANDIDATOS; ++c) {
+            microfonia_candidato_t *cand = &m->candidatos[c];
+            if (cand->bin != 0)
+                continue;
+            candidato_iniciar(cand, picos[j], log2_q8(potencia[picos[j]]) + 512 * expoente);
+            break;
+        }
+    }
+
+    return n_eventos;
+}
@@ -5,6 +5,7 @@
 #include <stdlib.h>          // Biblioteca padrão para alocação de memória
 #include "lib/ws2818b.pio.h" // Biblioteca para controle dos LEDs WS2818B via PIO
 #include "pico/stdlib.h"     // Biblioteca padrão para funções de delay e GPIO
+#include "lib/perfil.h"      // Tempo de envio ao PIO
 
 // Definicoes de hardware
 #define LED_PIN 25  // Pino do LED onboard do Raspberry Pi Pico
@@ -85,6 +86,7 @@ void npClear() {
  * Envia os dados do buffer para os LEDs, atualizando a matriz.
  */
 void npWrite() {
+  uint64_t inicio = perfil_inicio();
   // Envia cada valor de 8 bits (G, R, B) para a máquina de estado PIO
   for (uint i = 0; i < led_count; ++i) {
     pio_sm_put_blocking(np_pio, np_sm, leds[i].G);  // Envia o valor de verde
@@ -92,6 +94,7 @@ void npWrite() {
     pio_sm_put_blocking(np_pio, np_sm, leds[i].B);  // Envia o valor de azul
   }
   sleep_us(100);  // Aguarda 100us, conforme especificado no datasheet para o sinal de RESET
+  perfil_fim(PERFIL_LEDS_ESCRITA, inicio);
 }
 
 /**
@@ -126,6 +129,62 @@ void set_led_color_based_on_volume(float db) {
   npWrite(); // Atualiza a matriz de LEDs com as cores definidas
 }
 
+// Modo de exibicao da matriz de LEDs
+typedef enum {
+  LED_MODO_NIVEL,    // Matriz inteira com a cor do nivel em dB
+  LED_MODO_ESPECTRO  // Barras com o nivel das bandas de oitava
+} led_modo_t;
+
+/**
+ * Converte a coordenada (x, y) da matriz 5x5 no indice do LED. A fita e
+ * ligada em serpentina a partir do canto inferior direito; y = 0 e a linha
+ * de cima.
+ */
+static uint led_indice(uint x, uint y) {
+  return (y % 2 == 0) ? 24 - (y * 5 + x) : 24 - (y * 5 + (4 - x));
+}
+
+/**
+ * Desenha o espectro como 5 barras verticais. Cada coluna mostra o maior
+ * nivel de duas bandas de oitava vizinhas (0,1 dB); a altura e escalada
+ * entre min_ddb e max_ddb e a cor vai de verde a vermelho.
+ */
+void set_led_spectrum(const int16_t *oitava_ddb, uint bandas, int16_t min_ddb, int16_t max_ddb) {
+  npClear();
+
+  for (uint x = 0; x < 5; ++x) {
+    int16_t nivel = INT16_MIN;
+    for (uint b = x * bandas / 5; b < (x + 1) * bandas / 5; ++b) {
+      if (oitava_ddb[b] > nivel) nivel = oitava_ddb[b];
+    }
+
+    int altura = 0;
+    if (nivel > min_ddb) {
+      altura = (nivel - min_ddb) * 5 / (max_ddb - min_ddb) + 1;
+      if (altura > 5) altura = 5;
+    }
+
+    for (int h = 0; h < altura; ++h) {
+      uint8_t r = h * 20, g = 80 - h * 20;
+      npSetLED(led_indice(x, 4 - h), r, g, 0);
+    }
+  }
+
+  npWrite();
+}
+
+/**
+ * Alerta de microfonia: ponto de exclamacao amarelo no centro da matriz.
+ */
+void set_led_alerta_microfonia() {
+  npClear();
+  for (uint y = 0; y < 3; ++y) {
+    npSetLED(led_indice(2, y), 80, 60, 0);
+  }
+  npSetLED(led_indice(2, 4), 80, 60, 0);
+  npWrite();
+}
+
 // Funcao para limpar a matriz de LEDs NeoPixel
 void limpar_matriz_led() {
   for (int i = 0; i < LED_COUNT; i++) {
@@ -0,0 +1,463 @@
+#include "lib/nucleo_dsp.h"  // Pipeline de DSP no núcleo 1
+#include "lib/microfone.h"   // Captura contínua e cálculo de potência/dB
+#include "lib/fila_spsc.h"   // Fila sem travas até o núcleo 0
+#include "lib/ponderacao.h"  // Ponderação A/C/Z
+#include "lib/estatisticas.h" // Leq/Lmax/Lmin/Ln por janela
+#include "lib/espectro.h"    // FFT e bandas de oitava / 1/3 de oitava
+#include "lib/microfonia.h"  // Detector de microfonia
+#include "lib/decibel.h"     // dB em ponto fixo
+#include "lib/gravador.h"    // Anel de áudio com gatilho
+#include "lib/perfil.h"      // Tempo de cada etapa do bloco
+#include "pico/multicore.h"  // Inicialização do núcleo 1
+#include "pico/flash.h"      // Pausa segura do núcleo 1 durante gravações na flash
+#include "hardware/sync.h"   // __wfe/__sev
+
+// Fila de medições: o núcleo 1 produz, o núcleo 0 consome
+static medicao_t fila_armazenamento[DSP_FILA_CAPACIDADE];
+static fila_spsc_t fila_medicoes;
+
+// Eventos de microfonia: publicados assim que detectados, sem esperar a medição
+static microfonia_evento_t fila_microfonia_armazenamento[DSP_FILA_MICROFONIA_CAPACIDADE];
+static fila_spsc_t fila_microfonia;
+
+// Pedido do núcleo 0 para ligar/desligar a captura
+static volatile bool captura_solicitada = false;
+
+// Pausa da captura entre as janelas do modo de baixo consumo
+static volatile bool pausa_solicitada = false;
+
+// Suspensão da captura enquanto o núcleo 0 grava na flash: o núcleo 1 copia
+// o pedido para a confirmação depois de parar o DMA do ADC
+static volatile bool suspensao_solicitada = false;
+static volatile uint32_t suspensao_pedido = 0, suspensao_confirmada = 0;
+static bool iniciado = false;
+
+// Ponderação em frequência pedida pelo núcleo 0
+static volatile ponderacao_freq_t ponderacao_solicitada = DSP_PONDERACAO_PADRAO;
+
+// Modo de detecção de microfonia pedido pelo núcleo 0
+static volatile bool microfonia_solicitada = DSP_MICROFONIA_PADRAO;
+
+// Retenção do pico pedida pelo núcleo 0
+static volatile uint32_t pico_retencao_ms = DSP_PICO_RETENCAO_MS;
+static volatile uint32_t pico_decaimento_ddb_s = DSP_PICO_DECAIMENTO_DDB_S;
+
+// Estado da retenção de pico (peak hold), em milésimos de dB para o decaimento por bloco
+typedef struct {
+    int32_t nivel_mdb;           // Nível retido (0,001 dB)
+    uint32_t blocos_restantes;   // Blocos até começar a decair
+} retencao_pico_t;
+
+// Bloco convertido para o formato interno de áudio (processado no lugar)
+static int32_t amostras[SAMPLES];
+
+// Estatísticas de 1 min / 15 min / 1 h (memória fixa, ~22 KB)
+static estatisticas_t estatisticas;
+
+// Analisador de espectro (sem ponderação em frequência)
+static espectro_t espectro;
+
+// Detector de microfonia, alimentado por cada quadro do espectro
+static microfonia_t microfonia;
+
+/**
+ * Converte uma média quadrática (unidades internas^2) para tensão RMS (V).
+ */
+static float media_quadratica_para_volts(uint64_t media) {
+    uint32_t rms_q8 = isqrt64(media << (16 - 2 * AUDIO_FRAC_BITS));  // Códigos do ADC em Q8
+    return ADC_CODES_TO_VOLTS(rms_q8 / 256.f);
+}
+
+/**
+ * Converte uma média quadrática para décimos de dB (usada pelas estatísticas),
+ * em aritmética inteira.
+ */
+static int16_t media_quadratica_para_ddb(uint64_t media) {
+    int32_t mdb = mic_media_quadratica_para_mdb(media);
+    if (mdb == DECIBEL_MDB_ZERO)
+        return EST_DB_MIN * 10;  // Silêncio digital: log de zero
+    return (int16_t)((mdb + (mdb >= 0 ? 50 : -50)) / 100);
+}
+
+/**
+ * Converte uma média quadrática para dB (float só no resultado).
+ */
+static float media_quadratica_para_db(uint64_t media) {
+    int32_t mdb = mic_media_quadratica_para_mdb(media);
+    return mdb == DECIBEL_MDB_ZERO ? -INFINITY : mdb / 1000.f;
+}
+
+/**
+ * Retenção de pico: segura o maior nível por pico_retencao_ms e depois o
+ * deixa cair pico_decaimento_ddb_s décimos de dB por segundo, até alcançar
+ * o nível atual. Chamada uma vez por bloco.
+ */
+static void retencao_pico_atualizar(retencao_pico_t *retencao, int16_t nivel_ddb) {
+    const uint32_t blocos_por_segundo = AUDIO_BLOCOS_POR_SEGUNDO;
+    int32_t nivel_mdb = nivel_ddb * 100;
+
+    if (nivel_mdb >= retencao->nivel_mdb) {
+        retencao->nivel_mdb = nivel_mdb;
+        retencao->blocos_restantes = pico_retencao_ms * blocos_por_segundo / 1000;
+    } else if (retencao->blocos_restantes > 0) {
+        retencao->blocos_restantes--;
+    } else {
+        retencao->nivel_mdb -= (int32_t)(pico_decaimento_ddb_s * 100 / blocos_por_segundo);
+        if (retencao->nivel_mdb < nivel_mdb)
+            retencao->nivel_mdb = nivel_mdb;
+    }
+}
+
+/**
+ * Zera os integradores de todas as ponderações temporais.
+ */
+static void integradores_iniciar(integrador_tempo_t *integradores) {
+    for (uint t = 0; t < PONDERACAO_TEMPO_N; ++t)
+        integrador_tempo_init(&integradores[t], (ponderacao_tempo_t)t, SAMPLES, AUDIO_SAMPLE_RATE);
+}
+
+/**
+ * Laço principal do núcleo 1: captura, processa cada bloco e publica
+ * uma medição a cada DSP_BLOCOS_POR_MEDICAO blocos.
+ */
+static void nucleo1_main() {
+    // Permite que o núcleo 0 pause este núcleo enquanto grava na flash (config_flash)
+    flash_safe_execute_core_init();
+
+    // A interrupção do DMA é registrada no núcleo que chama microphone_init()
+    microphone_init();
+
+    filtro_ponderacao_t ponderacao;
+    ponderacao_init(&ponderacao, ponderacao_solicitada, AUDIO_SAMPLE_RATE);
+
+    // Todas as ponderações temporais rodam em paralelo sobre o mesmo fluxo
+    integrador_tempo_t integradores[PONDERACAO_TEMPO_N];
+    integradores_iniciar(integradores);
+
+    espectro_init(&espectro, AUDIO_SAMPLE_RATE);
+    microfonia_init(&microfonia, AUDIO_SAMPLE_RATE);
+
+    // Percentis sobre o nível Fast amostrado a cada bloco
+    estatisticas_init(&estatisticas, 60 * AUDIO_SAMPLE_RATE / SAMPLES, media_quadratica_para_ddb);
+
+    bool captura_ativa = false;
+    bool pausa_ativa = false;
+    uint descartar = 0;     // Blocos a ignorar depois de sair da pausa
+    bool microfonia_ativa = microfonia_solicitada;
+    uint64_t energia = 0;   // Soma dos quadrados (formato interno, ponderado) desde a última medição
+    uint64_t energia_z = 0; // Idem, sem ponderação (para o fator de crista)
+    int32_t pico = 0, pico_real = 0;  // Maiores picos do intervalo (formato interno)
+    int64_t soma_dc = 0;    // Soma das amostras sem ponderação (nível DC residual)
+    uint32_t saturadas_min = 0, saturadas_max = 0;
+    uint32_t tempo_decimacao_us = 0, tempo_dsp_us = 0;  // Tempo de processamento do intervalo
+    retencao_pico_t retencao = {0};
+    uint blocos = 0;
+    uint32_t sequencia = 0;
+
+    while (true) {
+        // Atende pedidos de ligar/desligar vindos do núcleo 0
+        if (captura_solicitada != captura_ativa) {
+            captura_ativa = captura_solicitada;
+            if (captura_ativa) {
+                mic_capture_start();
+            } else {
+                mic_capture_stop();
+            }
+            integradores_iniciar(integradores);
+            estatisticas_reiniciar(&estatisticas);
+            espectro_reiniciar(&espectro);
+            microfonia_reiniciar(&microfonia);
+            gravador_reiniciar();
+            retencao = (retencao_pico_t){0};
+            energia = energia_z = 0;
+            soma_dc = 0;
+            pico = pico_real = 0;
+            saturadas_min = saturadas_max = 0;
+            tempo_decimacao_us = tempo_dsp_us = 0;
+            blocos = 0;
+            pausa_ativa = false;
+        }
+
+        // Pausa do modo de baixo consumo: o ADC para entre as janelas de
+        // medição, mas as estatísticas e a retenção de pico continuam (as
+        // janelas de 1 min / 15 min / 1 h passam a contar só o tempo medido).
+        // A suspensão para uma gravação na flash usa a mesma pausa
+        bool pausar = pausa_solicitada || suspensao_solicitada;
+        if (captura_ativa && pausar != pausa_ativa) {
+            pausa_ativa = pausar;
+            if (pausa_ativa) {
+                mic_capture_stop();
+            } else {
+                mic_capture_start();
+                integradores_iniciar(integradores);
+                espectro_reiniciar(&espectro);
+                microfonia_reiniciar(&microfonia);
+                gravador_reiniciar();
+                energia = energia_z = 0;
+                soma_dc = 0;
+                pico = pico_real = 0;
+                saturadas_min = saturadas_max = 0;
+                tempo_decimacao_us = tempo_dsp_us = 0;
+                blocos = 0;
+                descartar = DSP_RETOMADA_DESCARTE_BLOCOS;
+            }
+        }
+        suspensao_confirmada = suspensao_pedido;
+
+        // Troca de ponderação: reprojeta o filtro e descarta o intervalo em andamento
+        if (ponderacao_solicitada != ponderacao.tipo) {
+            ponderacao_init(&ponderacao, ponderacao_solicitada, AUDIO_SAMPLE_RATE);
+            integradores_iniciar(integradores);
+            estatisticas_reiniciar(&estatisticas);  // Não mistura níveis de ponderações diferentes
+            energia = energia_z = 0;
+            soma_dc = 0;
+            pico = pico_real = 0;
+            saturadas_min = saturadas_max = 0;
+            tempo_decimacao_us = tempo_dsp_us = 0;
+            blocos = 0;
+        }
+
+        // Liga/desliga a detecção de microfonia; ao religar, esquece os picos antigos
+        if (microfonia_solicitada != microfonia_ativa) {
+            microfonia_ativa = microfonia_solicitada;
+            microfonia_reiniciar(&microfonia);
+        }
+
+        const uint16_t *bloco = captura_ativa && !pausa_ativa ? mic_capture_acquire() : NULL;
+        if (bloco == NULL) {
+            __wfe();  // Dorme até a próxima interrupção do DMA ou um __sev() do núcleo 0
+            continue;
+        }
+
+        // Decima e devolve o bloco logo, para o DMA não alcançá-lo; a mesma
+        // passada conta a saturação do ADC, mede energia e pico do áudio e
+        // grava o bloco decimado no anel do gravador
+        uint32_t inicio_us = time_us_32();
+        uint64_t etapa = perfil_inicio();
+        mic_bloco_info_t info;
+        mic_analisar_bloco(bloco, ADC_SAMPLES_BLOCO, amostras, gravador_proximo_bloco(), &info);
+        mic_capture_release();
+        perfil_fim(PERFIL_DECIMACAO, etapa);
+        if (descartar > 0) {
+            descartar--;  // Transitório da retomada: não entra em nenhuma medida
+            continue;
+        }
+        tempo_decimacao_us += time_us_32() - inicio_us;
+
+        // True peak sobre o bloco convertido (antes da ponderação, que é no lugar)
+        etapa = perfil_inicio();
+        int32_t pico_real_bloco = mic_true_peak(amostras, SAMPLES, info.pico);
+        perfil_fim(PERFIL_TRUE_PEAK, etapa);
+        energia_z += info.energia;
+        soma_dc += info.soma;
+        if (info.pico > pico)
+            pico = info.pico;
+        if (pico_real_bloco > pico_real)
+            pico_real = pico_real_bloco;
+        saturadas_min += info.saturadas_min;
+        saturadas_max += info.saturadas_max;
+        const int16_t pico_real_ddb = media_quadratica_para_ddb((uint64_t)pico_real_bloco * pico_real_bloco);
+        retencao_pico_atualizar(&retencao, pico_real_ddb);
+
+        // O espectro usa o sinal antes da ponderação (bandas em dB Z)
+        bool microfonia_detectada = false;
+        etapa = perfil_inicio();
+        if (espectro_adicionar(&espectro, amostras, SAMPLES) && microfonia_ativa) {
+            // Quadro novo: procura microfonia e publica na hora (latência de um quadro)
+            microfonia_evento_t eventos[MICROFONIA_CANDIDATOS];
+            uint n = microfonia_quadro(&microfonia, espectro.potencia, espectro.expoente, eventos);
+            for (uint i = 0; i < n; ++i) {
+                eventos[i].tempo_ms = to_ms_since_boot(get_absolute_time());
+                fila_spsc_push(&fila_microfonia, &eventos[i]);
+            }
+            microfonia_detectada = n > 0;
+        }
+        perfil_fim(PERFIL_ESPECTRO, etapa);
+
+        // Ponderação em frequência e energia, tudo em aritmética inteira
+        etapa = perfil_inicio();
+        ponderacao_processar(&ponderacao, amostras, SAMPLES);
+        uint64_t energia_bloco = mic_energy_samples(amostras, SAMPLES);
+        energia += energia_bloco;
+
+        // Ponderações temporais: O(1) por bloco cada
+        for (uint t = 0; t < PONDERACAO_TEMPO_N; ++t)
+            integrador_tempo_atualizar(&integradores[t], energia_bloco, SAMPLES);
+
+        // Estatísticas: energia do bloco para o Leq, nível Fast para os percentis
+        const int16_t nivel_rapido_ddb =
+            media_quadratica_para_ddb(integrador_tempo_valor(&integradores[PONDERACAO_RAPIDA]));
+        estatisticas_adicionar(&estatisticas, energia_bloco / SAMPLES, nivel_rapido_ddb);
+        perfil_fim(PERFIL_NIVEL, etapa);
+
+        // Fecha o bloco gravado e verifica os gatilhos da gravação
+        etapa = perfil_inicio();
+        gravador_concluir_bloco(nivel_rapido_ddb, pico_real_ddb, microfonia_detectada);
+        perfil_fim(PERFIL_GRAVADOR, etapa);
+        tempo_dsp_us += time_us_32() - inicio_us;
+
+        if (++blocos < DSP_BLOCOS_POR_MEDICAO)
+            continue;
+
+        // Nível equivalente (energia média) de todo o intervalo
+        etapa = perfil_inicio();
+        const uint64_t media = energia / ((uint64_t)blocos * SAMPLES);
+        float rms = media_quadratica_para_volts(media);
+
+        mic_capture_stats_t captura;
+        mic_capture_get_stats(&captura);
+
+        medicao_t medicao = {
+            .sequencia = sequencia++,
+            .tempo_ms = to_ms_since_boot(get_absolute_time()),
+            .rms = rms,
+            .db = media_quadratica_para_db(media),
+            .ponderacao = ponderacao.tipo,
+            .blocos = blocos,
+            .blocos_perdidos = captura.blocks_dropped,
+            .blocos_sobrescritos = captura.blocks_overrun,
+        };
+        for (uint t = 0; t < PONDERACAO_TEMPO_N; ++t)
+            medicao.db_tempo[t] = media_quadratica_para_db(integrador_tempo_valor(&integradores[t]));
+
+        // Nível médio de cada banda sobre os quadros do intervalo
+        static uint64_t bandas_terco[ESPECTRO_BANDAS_TERCO], bandas_oitava[ESPECTRO_BANDAS_OITAVA];
+        espectro_bandas(&espectro, bandas_terco, bandas_oitava);
+        for (uint b = 0; b < ESPECTRO_BANDAS_TERCO; ++b)
+            medicao.terco_ddb[b] = media_quadratica_para_ddb(bandas_terco[b]);
+        for (uint b = 0; b < ESPECTRO_BANDAS_OITAVA; ++b)
+            medicao.oitava_ddb[b] = media_quadratica_para_ddb(bandas_oitava[b]);
+
+        // Picos do intervalo, em dB na mesma escala dos níveis RMS
+        medicao.pico_ddb = media_quadratica_para_ddb((uint64_t)pico * pico);
+        medicao.pico_real_ddb = media_quadratica_para_ddb((uint64_t)pico_real * pico_real);
+        medicao.pico_retido_ddb = (int16_t)(retencao.nivel_mdb / 100);
+        medicao.fator_crista_ddb = medicao.pico_real_ddb -
+                                   media_quadratica_para_ddb(energia_z / ((uint64_t)blocos * SAMPLES));
+        medicao.saturadas_min = saturadas_min;
+        medicao.saturadas_max = saturadas_max;
+        medicao.dc = (int32_t)(soma_dc / (int64_t)(blocos * SAMPLES));
+
+        // Carga do núcleo 1 em relação à duração do áudio do intervalo
+        const uint32_t duracao_us = blocos * (1000000 / AUDIO_BLOCOS_POR_SEGUNDO);
+        medicao.carga_decimacao_pm = (uint16_t)((uint64_t)tempo_decimacao_us * 1000 / duracao_us);
+        medicao.carga_dsp_pm = (uint16_t)((uint64_t)tempo_dsp_us * 1000 / duracao_us);
+
+        for (uint j = 0; j < EST_JANELAS; ++j) {
+            estatisticas_parcial(&estatisticas, (est_janela_t)j, &medicao.est_parcial[j]);
+            medicao.est_completa[j] = estatisticas.ultima[j];
+        }
+        fila_spsc_push(&fila_medicoes, &medicao);  // Se a fila estiver cheia a medição é contada como descartada
+        perfil_fim(PERFIL_PUBLICACAO, etapa);
+
+        energia = energia_z = 0;
+        soma_dc = 0;
+        pico = pico_real = 0;
+        saturadas_min = saturadas_max = 0;
+        tempo_decimacao_us = tempo_dsp_us = 0;
+        blocos = 0;
+    }
+}
+
+/**
+ * Inicializa a fila de medições e coloca o núcleo 1 para rodar a captura e o DSP.
+ */
+void nucleo_dsp_iniciar() {
+    fila_spsc_init(&fila_medicoes, fila_armazenamento, sizeof(medicao_t), DSP_FILA_CAPACIDADE);
+    fila_spsc_init(&fila_microfonia, fila_microfonia_armazenamento, sizeof(microfonia_evento_t),
+                   DSP_FILA_MICROFONIA_CAPACIDADE);
+    multicore_launch_core1(nucleo1_main);
+    iniciado = true;
+}
+
+/**
+ * Liga ou desliga a captura no núcleo 1.
+ */
+void nucleo_dsp_ligar(bool ligado) {
+    captura_solicitada = ligado;
+    __sev();  // Acorda o núcleo 1 se ele estiver em __wfe()
+}
+
+/**
+ * Pausa ou retoma a captura sem perder as estatísticas (modo de baixo
+ * consumo). A primeira medição depois da retomada sai após
+ * DSP_RETOMADA_DESCARTE_BLOCOS + DSP_BLOCOS_POR_MEDICAO blocos.
+ */
+void nucleo_dsp_pausar(bool pausado) {
+    pausa_solicitada = pausado;
+    __sev();
+}
+
+/**
+ * Para a captura antes de uma gravação na flash e a retoma depois. Com o
+ * núcleo 1 pausado pelo flash_safe_execute, ninguém volta o endereço de
+ * escrita do DMA ao início do buffer e o ping-pong passaria do fim de
+ * adc_buffer. Ao suspender, espera o núcleo 1 parar o DMA e retorna false
+ * se ele não responder em DSP_SUSPENSAO_TIMEOUT_MS. A retomada descarta os
+ * blocos do transitório, como a do modo de baixo consumo.
+ */
+bool nucleo_dsp_suspender(bool suspenso) {
+    if (!iniciado)
+        return true;
+    suspensao_solicitada = suspenso;
+    uint32_t pedido = ++suspensao_pedido;
+    __sev();
+    if (!suspenso)
+        return true;
+
+    absolute_time_t prazo = make_timeout_time_ms(DSP_SUSPENSAO_TIMEOUT_MS);
+    while (suspensao_confirmada != pedido) {
+        if (time_reached(prazo))
+            return false;
+        busy_wait_us(50);
+    }
+    return true;
+}
+
+/**
+ * Seleciona a ponderação em frequência usada pelo núcleo 1.
+ */
+void nucleo_dsp_set_ponderacao(ponderacao_freq_t tipo) {
+    ponderacao_solicitada = tipo;
+    __sev();
+}
+
+/**
+ * Retira a medição mais antiga da fila (núcleo 0). Não bloqueia.
+ */
+bool nucleo_dsp_obter_medicao(medicao_t *medicao) {
+    return fila_spsc_pop(&fila_medicoes, medicao);
+}
+
+/**
+ * Liga ou desliga o modo de detecção de microfonia no núcleo 1.
+ */
+void nucleo_dsp_set_microfonia(bool ligado) {
+    microfonia_solicitada = ligado;
+    __sev();
+}
+
+/**
+ * Configura a retenção do pico: tempo parado (ms) e decaimento depois
+ * dele (décimos de dB por segundo).
+ */
+void nucleo_dsp_set_retencao_pico(uint32_t retencao_ms, uint32_t decaimento_ddb_s) {
+    pico_retencao_ms = retencao_ms;
+    pico_decaimento_ddb_s = decaimento_ddb_s;
+}
+
+/**
+ * Retira o evento de microfonia mais antigo (núcleo 0). Não bloqueia.
+ */
+bool nucleo_dsp_obter_microfonia(microfonia_evento_t *evento) {
+    return fila_spsc_pop(&fila_microfonia, evento);
+}
+
+/**
+ * Copia a ocupação e os contadores da fila de medições.
+ */
+void nucleo_dsp_get_stats(nucleo_dsp_stats_t *stats) {
+    stats->profundidade = fila_spsc_profundidade(&fila_medicoes);
+    stats->profundidade_max = fila_medicoes.profundidade_max;
+    stats->descartados = fila_medicoes.descartados;
+}
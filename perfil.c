@@ -0,0 +1,92 @@
+#include "lib/perfil.h"  // Perfil das etapas e uso de memória
+#include <malloc.h>      // mallinfo
+#include <stdio.h>
+
+perfil_etapa_t perfil_etapas[PERFIL_ETAPAS];
+
+// Limites do heap e das pilhas, do script do linker do SDK
+extern uint32_t __end__, __StackLimit;
+extern uint32_t __StackBottom, __StackTop;        // Pilha do núcleo 0 (SCRATCH_Y)
+extern uint32_t __StackOneBottom, __StackOneTop;  // Pilha do núcleo 1 (SCRATCH_X)
+
+static const char *nomes[PERFIL_ETAPAS] = {
+    [PERFIL_DECIMACAO] = "decimacao",
+    [PERFIL_TRUE_PEAK] = "true peak",
+    [PERFIL_ESPECTRO] = "espectro",
+    [PERFIL_NIVEL] = "nivel",
+    [PERFIL_GRAVADOR] = "gravador",
+    [PERFIL_PUBLICACAO] = "publicacao",
+    [PERFIL_LEDS] = "leds",
+    [PERFIL_LEDS_ESCRITA] = "leds npWrite",
+    [PERFIL_OLED] = "oled",
+    [PERFIL_OLED_TEXTO] = "oled texto",
+    [PERFIL_OLED_ENVIO] = "oled envio",
+    [PERFIL_REDE] = "rede",
+    [PERFIL_ENVIO] = "envio",
+};
+
+/**
+ * Pinta a parte livre das pilhas com PERFIL_PINTURA. Deve ser chamada no
+ * núcleo 0, antes de o núcleo 1 começar: pinta a pilha inteira do núcleo 1
+ * e a do núcleo 0 abaixo da função atual.
+ */
+void perfil_init() {
+    uint32_t marca;
+    for (uint32_t *p = &__StackBottom; p < &marca - 16; ++p)
+        *p = PERFIL_PINTURA;
+    for (uint32_t *p = &__StackOneBottom; p < &__StackOneTop; ++p)
+        *p = PERFIL_PINTURA;
+}
+
+/**
+ * Profundidade máxima de uma pilha: a primeira palavra que perdeu a pintura.
+ */
+static uint32_t pilha_max(const uint32_t *base, const uint32_t *topo) {
+    const uint32_t *p = base;
+    while (p < topo && *p == PERFIL_PINTURA)
+        ++p;
+    return (uint32_t)((topo - p) * sizeof(uint32_t));
+}
+
+/**
+ * Uso do heap agora e no máximo, e marca d'água das duas pilhas.
+ */
+void perfil_get_memoria(perfil_memoria_t *memoria) {
+    struct mallinfo m = mallinfo();
+    memoria->heap_total = (uint32_t)((uintptr_t)&__StackLimit - (uintptr_t)&__end__);
+    memoria->heap_usado = (uint32_t)m.uordblks;
+    memoria->heap_max = (uint32_t)m.arena;  // O newlib não devolve o que pegou do sbrk
+    memoria->pilha_total[0] = (uint32_t)((uintptr_t)&__StackTop - (uintptr_t)&__StackBottom);
+    memoria->pilha_total[1] = (uint32_t)((uintptr_t)&__StackOneTop - (uintptr_t)&__StackOneBottom);
+    memoria->pilha_max[0] = pilha_max(&__StackBottom, &__StackTop);
+    memoria->pilha_max[1] = pilha_max(&__StackOneBottom, &__StackOneTop);
+}
+
+/**
+ * Imprime, por etapa, contagem, mínimo, média, máximo e o histograma (só as
+ * faixas ocupadas, como <limite em us>:<contagem>), e o uso de memória.
+ */
+void perfil_relatorio() {
+    for (uint i = 0; i < PERFIL_ETAPAS; ++i) {
+        perfil_etapa_t e = perfil_etapas[i];  // Cópia: o núcleo 1 continua atualizando
+        if (e.contagem == 0)
+            continue;
+        printf("[PERFIL] %-12s %7u x, min %6u, media %6u, max %6u us |", nomes[i], (unsigned)e.contagem,
+               (unsigned)e.min_us, (unsigned)(e.total_us / e.contagem), (unsigned)e.max_us);
+        for (uint k = 0; k < PERFIL_HISTOGRAMA; ++k) {
+            if (e.histograma[k] == 0)
+                continue;
+            if (k == PERFIL_HISTOGRAMA - 1)
+                printf(" >=%u:%u", 1u << k, (unsigned)e.histograma[k]);
+            else
+                printf(" <%u:%u", 2u << k, (unsigned)e.histograma[k]);
+        }
+        printf("\n");
+    }
+
+    perfil_memoria_t m;
+    perfil_get_memoria(&m);
+    printf("[PERFIL] Heap: %u usados, max %u de %u bytes; pilhas: nucleo 0 max %u de %u, nucleo 1 max %u de %u bytes\n",
+           (unsigned)m.heap_usado, (unsigned)m.heap_max, (unsigned)m.heap_total, (unsigned)m.pilha_max[0],
+           (unsigned)m.pilha_total[0], (unsigned)m.pilha_max[1], (unsigned)m.pilha_total[1]);
+}
@@ -0,0 +1,234 @@
+#include "lib/ponderacao.h"  // Filtros de ponderação A/C/Z
+#include <math.h>
+#include <complex.h>
+
+// Frequências dos polos das curvas A e C (IEC 61672-1, anexo E)
+#define PONDERACAO_F1 20.598997
+#define PONDERACAO_F2 107.65265
+#define PONDERACAO_F3 737.86223
+#define PONDERACAO_F4 12194.217
+
+#define Q30(x) ((int32_t)lround((x) * (1 << 30)))
+
+/**
+ * Preenche uma seção a partir dos seus dois polos (no plano z), reais ou
+ * um par conjugado.
+ */
+static void biquad_polos(biquad_t *b, int8_t zeros, double complex p1, double complex p2) {
+    b->a1 = Q30(-creal(p1 + p2));
+    b->a2 = Q30(creal(p1 * p2));
+    b->zeros = zeros;
+    b->x1 = b->x2 = b->y1 = b->y2 = 0;
+}
+
+/**
+ * Resposta complexa da cascata (sem o ganho final) na frequência f,
+ * usando os coeficientes já quantizados.
+ */
+static double complex ponderacao_resposta(const filtro_ponderacao_t *filtro, double f, uint32_t taxa_amostragem) {
+    double complex zi = cexp(-I * 2.0 * M_PI * f / taxa_amostragem);  // z^-1
+    double complex h = 1.0;
+
+    for (uint s = 0; s < filtro->secoes; ++s) {
+        const biquad_t *b = &filtro->biquad[s];
+        double complex num = b->zeros ? (1.0 - b->zeros * zi) * (1.0 - b->zeros * zi) : 1.0;
+        double complex den = 1.0 + (b->a1 / 1073741824.0) * zi + (b->a2 / 1073741824.0) * zi * zi;
+        h *= num / den;
+    }
+    return h;
+}
+
+/**
+ * Determinante 3x3 (regra de Cramer em passa_baixas_casado).
+ */
+static double det3(const double m[3][3]) {
+    return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+           m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+           m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+}
+
+/**
+ * Passa-baixas em F4 para taxas abaixo de 44,1 kHz: dois polos sem zeros
+ * com |H|^2 igual ao da curva analógica, (F4^2 / (f^2 + F4^2))^2, em 0,
+ * 0,2 fs e 0,4 fs. Para um filtro só de polos, 1 / |H|^2 vale
+ * e0 + e1 cos w + e2 cos 2w: os e saem de um sistema 3x3, e os polos da
+ * fatoração espectral (com x = z + 1/z o polinômio vira uma equação do
+ * segundo grau; de cada par z, 1/z fica o de dentro do círculo).
+ */
+static void passa_baixas_casado(biquad_t *b, uint32_t taxa_amostragem) {
+    static const double pontos[3] = {0.0, 0.2, 0.4};  // Frações da taxa de amostragem
+    double m[3][3], alvo[3], e[3];
+
+    for (int i = 0; i < 3; ++i) {
+        double w = 2.0 * M_PI * pontos[i];
+        double f = pontos[i] * taxa_amostragem;
+        double t = (f * f + PONDERACAO_F4 * PONDERACAO_F4) / (PONDERACAO_F4 * PONDERACAO_F4);
+        m[i][0] = 1.0;
+        m[i][1] = cos(w);
+        m[i][2] = cos(2.0 * w);
+        alvo[i] = t * t;
+    }
+    const double d = det3(m);
+    for (int j = 0; j < 3; ++j) {
+        double mj[3][3];
+        for (int i = 0; i < 3; ++i)
+            for (int k = 0; k < 3; ++k)
+                mj[i][k] = k == j ? alvo[i] : m[i][k];
+        e[j] = det3(mj) / d;
+    }
+
+    // e2/2 (x^2 - 2) + e1/2 x + e0 = 0
+    double complex raiz = csqrt(e[1] * e[1] / 4.0 - 2.0 * e[2] * (e[0] - e[2]));
+    double complex x[2] = {(-e[1] / 2.0 + raiz) / e[2], (-e[1] / 2.0 - raiz) / e[2]};
+    double complex polo[2];
+    for (int i = 0; i < 2; ++i) {
+        polo[i] = (x[i] - csqrt(x[i] * x[i] - 4.0)) / 2.0;
+        if (cabs(polo[i]) > 1.0)
+            polo[i] = 1.0 / polo[i];
+    }
+    biquad_polos(b, 0, polo[0], polo[1]);
+}
+
+/**
+ * Projeta o filtro de ponderação para a taxa de amostragem efetiva.
+ * Os passa-altas (polos em F1, F2, F3) usam a transformada bilinear. O
+ * passa-baixas em F4 usa a bilinear a partir de 44,1 kHz; abaixo disso a
+ * distorção de frequência perto de Nyquist sai da tolerância classe 1
+ * (assim como os polos casados, matched-z, que sobem demais perto de
+ * Nyquist), e os polos saem de passa_baixas_casado().
+ * Executado só na inicialização (ponto flutuante não importa aqui).
+ */
+void ponderacao_init(filtro_ponderacao_t *filtro, ponderacao_freq_t tipo, uint32_t taxa_amostragem) {
+    const double k = 2.0 * taxa_amostragem;
+    #define POLO_BILINEAR(f) ((k - 2.0 * M_PI * (f)) / (k + 2.0 * M_PI * (f)))
+
+    filtro->tipo = tipo;
+    filtro->secoes = 0;
+    filtro->ganho = Q30(1.0);
+    if (tipo == PONDERACAO_Z)
+        return;
+
+    // Passa-altas duplo em F1 (comum às curvas A e C)
+    biquad_polos(&filtro->biquad[filtro->secoes++], +1, POLO_BILINEAR(PONDERACAO_F1), POLO_BILINEAR(PONDERACAO_F1));
+
+    // Passa-altas em F2 e F3 (só curva A)
+    if (tipo == PONDERACAO_A)
+        biquad_polos(&filtro->biquad[filtro->secoes++], +1, POLO_BILINEAR(PONDERACAO_F2), POLO_BILINEAR(PONDERACAO_F3));
+
+    // Passa-baixas duplo em F4
+    if (taxa_amostragem >= 44100) {
+        biquad_polos(&filtro->biquad[filtro->secoes++], -1, POLO_BILINEAR(PONDERACAO_F4), POLO_BILINEAR(PONDERACAO_F4));
+    } else {
+        passa_baixas_casado(&filtro->biquad[filtro->secoes++], taxa_amostragem);
+    }
+    #undef POLO_BILINEAR
+
+    // Normaliza para 0 dB em 1 kHz (definição das curvas A e C)
+    filtro->ganho = Q30(1.0 / cabs(ponderacao_resposta(filtro, 1000.0, taxa_amostragem)));
+}
+
+/**
+ * Aplica uma seção a um bloco inteiro (forma direta I).
+ * Só os polos usam multiplicação; os zeros duplos viram somas.
+ */
+static void biquad_processar(biquad_t *b, int32_t *amostras, uint n) {
+    const int32_t a1 = b->a1, a2 = b->a2;
+    int32_t x1 = b->x1, x2 = b->x2, y1 = b->y1, y2 = b->y2;
+
+    for (uint i = 0; i < n; ++i) {
+        int32_t x = amostras[i];
+        int32_t v;
+        switch (b->zeros) {
+        case 1:  v = x - 2 * x1 + x2; break;   // (1 - z^-1)^2
+        case -1: v = x + 2 * x1 + x2; break;   // (1 + z^-1)^2
+        default: v = x; break;
+        }
+
+        int64_t acc = (int64_t)a1 * y1 + (int64_t)a2 * y2;
+        int32_t y = v - (int32_t)((acc + (1 << 29)) >> 30);
+
+        x2 = x1; x1 = x;
+        y2 = y1; y1 = y;
+        amostras[i] = y;
+    }
+
+    b->x1 = x1; b->x2 = x2; b->y1 = y1; b->y2 = y2;
+}
+
+/**
+ * Aplica a ponderação em um bloco de amostras (no próprio buffer).
+ * Processa seção por seção para manter o estado em registradores.
+ */
+void ponderacao_processar(filtro_ponderacao_t *filtro, int32_t *amostras, uint n) {
+    if (filtro->secoes == 0)
+        return;  // Ponderação Z: passa direto
+
+    // Bits de guarda reduzem o ruído de arredondamento realimentado pelos polos de baixa frequência
+    for (uint i = 0; i < n; ++i)
+        amostras[i] <<= PONDERACAO_GUARDA;
+
+    for (uint s = 0; s < filtro->secoes; ++s)
+        biquad_processar(&filtro->biquad[s], amostras, n);
+
+    const int32_t ganho = filtro->ganho;
+    for (uint i = 0; i < n; ++i)
+        amostras[i] = (int32_t)(((int64_t)amostras[i] * ganho + (1ll << (29 + PONDERACAO_GUARDA))) >> (30 + PONDERACAO_GUARDA));
+}
+
+/**
+ * Retorna o nome curto da ponderação ("Z", "A" ou "C").
+ */
+const char* ponderacao_nome(ponderacao_freq_t tipo) {
+    switch (tipo) {
+    case PONDERACAO_A: return "A";
+    case PONDERACAO_C: return "C";
+    default:           return "Z";
+    }
+}
+
+/**
+ * Prepara um integrador de ponderação temporal para blocos de tamanho fixo.
+ * A constante por bloco é 1 - exp(-T_bloco / tau), equivalente ao
+ * integrador RC amostra a amostra quando tau >> T_bloco.
+ */
+void integrador_tempo_init(integrador_tempo_t *integrador, ponderacao_tempo_t tipo, uint amostras_bloco, uint32_t taxa_amostragem) {
+    static const float tau_subida[PONDERACAO_TEMPO_N] = {0.125f, 1.0f, 0.035f};
+    static const float tau_descida[PONDERACAO_TEMPO_N] = {0.125f, 1.0f, 1.5f};
+    const float t_bloco = (float)amostras_bloco / taxa_amostragem;
+
+    integrador->tipo = tipo;
+    integrador->alfa_subida = (uint32_t)lroundf((1.f - expf(-t_bloco / tau_subida[tipo])) * 65536.f);
+    integrador->alfa_descida = (uint32_t)lroundf((1.f - expf(-t_bloco / tau_descida[tipo])) * 65536.f);
+    integrador->media = 0;
+}
+
+/**
+ * Atualiza o integrador com a energia de um bloco. Custo constante por
+ * bloco, independente da constante de tempo.
+ */
+void integrador_tempo_atualizar(integrador_tempo_t *integrador, uint64_t energia_bloco, uint amostras_bloco) {
+    uint64_t alvo = (energia_bloco << 16) / amostras_bloco;  // Média quadrática do bloco em Q16
+
+    if (alvo > integrador->media)
+        integrador->media += ((alvo - integrador->media) * integrador->alfa_subida) >> 16;
+    else
+        integrador->media -= ((integrador->media - alvo) * integrador->alfa_descida) >> 16;
+}
+
+/**
+ * Retorna a média quadrática ponderada (unidades internas^2).
+ */
+uint64_t integrador_tempo_valor(const integrador_tempo_t *integrador) {
+    return integrador->media >> 16;
+}
+
+/**
+ * Retorna a letra da ponderação temporal ("F", "S" ou "I").
+ */
+const char* ponderacao_tempo_nome(ponderacao_tempo_t tipo) {
+    switch (tipo) {
+    case PONDERACAO_LENTA:   return "S";
+    case PONDERACAO_IMPULSO: return "I";
+    default:                 return "F";
+    }
+}
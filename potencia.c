@@ -0,0 +1,76 @@
+#include "lib/potencia.h"  // Potência e RMS dos blocos do ADC
+#include <math.h>
+
+/**
+ * Calcula a potência média das leituras de um bloco do ADC (valor RMS).
+ * Versão de referência em ponto flutuante (inclui o nível DC); o caminho
+ * de medição usa mic_energy()/mic_power_fixed().
+ */
+float mic_power(const uint16_t *buffer, uint n) {
+    float avg = 0.f;
+
+    // Soma os quadrados das amostras para calcular a potência
+    for (uint i = 0; i < n; ++i)
+        avg += buffer[i] * buffer[i];
+    
+    avg /= n;  // Calcula a média
+    return sqrt(avg); // Retorna a raiz quadrada (valor RMS)
+}
+
+/**
+ * Soma dos quadrados de um bloco do ADC após remover o bias de 1,65 V.
+ * Versão inteira do núcleo de mic_power(): 4 amostras por iteração, com os
+ * quatro quadrados somados em 32 bits (cabem: 4 * 2048^2 < 2^25) antes de
+ * entrar no acumulador de 64 bits.
+ */
+uint64_t mic_energy(const uint16_t *buffer, uint n) {
+    uint64_t energia = 0;
+    const uint16_t *p = buffer;
+    const uint16_t *fim4 = buffer + (n & ~3u);
+
+    while (p < fim4) {
+        int32_t a = (int32_t)p[0] - ADC_BIAS_CODE;
+        int32_t b = (int32_t)p[1] - ADC_BIAS_CODE;
+        int32_t c = (int32_t)p[2] - ADC_BIAS_CODE;
+        int32_t d = (int32_t)p[3] - ADC_BIAS_CODE;
+        energia += (uint32_t)(a * a + b * b + c * c + d * d);
+        p += 4;
+    }
+
+    // Amostras restantes quando n não é múltiplo de 4
+    for (; p < buffer + n; ++p) {
+        int32_t a = (int32_t)*p - ADC_BIAS_CODE;
+        energia += (uint32_t)(a * a);
+    }
+    return energia;
+}
+
+/**
+ * Raiz quadrada inteira (piso) de um valor de 64 bits, bit a bit.
+ */
+uint32_t isqrt64(uint64_t x) {
+    uint64_t raiz = 0;
+    uint64_t bit = 1ull << 62;
+
+    while (bit > x)
+        bit >>= 2;
+
+    while (bit) {
+        if (x >= raiz + bit) {
+            x -= raiz + bit;
+            raiz = (raiz >> 1) + bit;
+        } else {
+            raiz >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)raiz;
+}
+
+/**
+ * Calcula o valor RMS (sem o nível DC) de n amostras em aritmética inteira.
+ * Retorna em códigos do ADC no formato Q8 (RMS * 256).
+ */
+uint32_t mic_power_fixed(const uint16_t *buffer, uint n) {
+    return isqrt64((mic_energy(buffer, n) << 16) / n);
+}
@@ -0,0 +1,161 @@
+#include "lib/registro.h"   // Registro binário adiado
+#include "lib/fila_spsc.h"  // Uma fila por núcleo produtor
+#include "hardware/sync.h"   // Reserva e publicação sem interrupções no meio
+#include <stdio.h>
+#include <string.h>
+
+#define REGISTRO_TEXTO(id, formato) formato,
+static const char *formatos[REGISTRO_NUM_FORMATOS] = {REGISTRO_FORMATOS(REGISTRO_TEXTO)};
+#undef REGISTRO_TEXTO
+
+static fila_spsc_t filas[2];
+static registro_t armazenamento[2][REGISTRO_CAPACIDADE];
+static uint32_t perdidos_avisados[2];  // Descartes já informados pela linha REG_PERDIDOS
+
+/**
+ * Inicializa as filas dos dois núcleos.
+ */
+void registro_init() {
+    for (uint n = 0; n < 2; ++n) {
+        fila_spsc_init(&filas[n], armazenamento[n], sizeof(registro_t), REGISTRO_CAPACIDADE);
+        perdidos_avisados[n] = 0;
+    }
+}
+
+/**
+ * Grava um registro na fila do núcleo atual, direto na posição reservada.
+ * As interrupções ficam desligadas entre a reserva e a publicação: um
+ * callback do lwIP (interrupção no núcleo 0) que registre no meio de uma
+ * tarefa seria um segundo produtor na mesma posição. Use pela macro REGISTRO().
+ */
+void registro_escrever(registro_formato_t formato, const uint32_t *args, uint num_args) {
+    if (num_args > REGISTRO_MAX_ARGS)
+        num_args = REGISTRO_MAX_ARGS;
+    uint32_t status = save_and_disable_interrupts();
+    fila_spsc_t *fila = &filas[get_core_num()];
+    registro_t *r = fila_spsc_reservar(fila);
+    if (r != NULL) {  // Fila cheia: contado em fila->descartados
+        r->tempo_us = time_us_32();
+        r->formato = (uint16_t)formato;
+        r->num_args = (uint8_t)num_args;
+        for (uint i = 0; i < num_args; ++i)
+            r->args[i] = args[i];
+        fila_spsc_publicar(fila);
+    }
+    restore_interrupts(status);
+}
+
+/**
+ * Avança até a próxima conversão do formato e retorna a sua letra (0 no fim).
+ */
+static char proxima_conversao(const char **formato) {
+    const char *p = *formato;
+    while (*p) {
+        if (*p++ != '%')
+            continue;
+        if (*p == '%') {
+            ++p;
+            continue;
+        }
+        while (*p && strchr("diuxXcfeEgGs", *p) == NULL)
+            ++p;  // Flags, largura, precisão e tamanho
+        if (*p) {
+            *formato = p + 1;
+            return *p;
+        }
+    }
+    *formato = p;
+    return 0;
+}
+
+/**
+ * Escreve os bytes menos significativos primeiro, em hexadecimal.
+ */
+static char *hex(char *saida, uint32_t valor, uint bytes) {
+    static const char digitos[] = "0123456789abcdef";
+    for (uint i = 0; i < bytes; ++i, valor >>= 8) {
+        *saida++ = digitos[(valor >> 4) & 0xF];
+        *saida++ = digitos[valor & 0xF];
+    }
+    return saida;
+}
+
+/**
+ * Envia um registro como "[R] " seguido de tempo (4 bytes), formato (2) e,
+ * para cada conversão, o argumento (4 bytes) ou, em %s, o tamanho (1) e os
+ * bytes do texto.
+ */
+static void enviar(const registro_t *r) {
+    static char linha[8 + 2 * (6 + REGISTRO_MAX_ARGS * (1 + REGISTRO_TEXTO_MAX))];
+    char *p = hex(linha, r->tempo_us, 4);
+    p = hex(p, r->formato, 2);
+
+    const char *formato = r->formato < REGISTRO_NUM_FORMATOS ? formatos[r->formato] : "";
+    char conversao;
+    for (uint i = 0; i < r->num_args && (conversao = proxima_conversao(&formato)) != 0; ++i) {
+        if (conversao != 's') {
+            p = hex(p, r->args[i], 4);
+            continue;
+        }
+        const char *texto = (const char *)(uintptr_t)r->args[i];
+        uint tamanho = texto ? strnlen(texto, REGISTRO_TEXTO_MAX) : 0;
+        p = hex(p, tamanho, 1);
+        for (uint c = 0; c < tamanho; ++c)
+            p = hex(p, (uint8_t)texto[c], 1);
+    }
+    *p = '\0';
+    printf("[R] %s\n", linha);
+}
+
+/**
+ * Envia pela USB até maximo registros das duas filas (núcleo 0, fora de
+ * interrupções), avisando antes os descartes novos de cada fila.
+ * Retorna o número de registros enviados.
+ */
+uint registro_drenar(uint maximo) {
+    uint enviados = 0;
+    for (uint n = 0; n < 2; ++n) {
+        uint32_t descartados = filas[n].descartados;
+        if (descartados != perdidos_avisados[n]) {
+            registro_t aviso = {
+                .tempo_us = time_us_32(),
+                .formato = REG_PERDIDOS,
+                .num_args = 2,
+                .args = {descartados - perdidos_avisados[n], n},
+            };
+            enviar(&aviso);
+            perdidos_avisados[n] = descartados;
+        }
+
+        registro_t r;
+        while (enviados < maximo && fila_spsc_pop(&filas[n], &r)) {
+            enviar(&r);
+            enviados++;
+        }
+    }
+    return enviados;
+}
+
+/**
+ * Copia os contadores das duas filas.
+ */
+void registro_get_stats(registro_stats_t *stats) {
+    for (uint n = 0; n < 2; ++n) {
+        stats->perdidos[n] = filas[n].descartados;
+        stats->escritos[n] = filas[n].cabeca;
+        stats->profundidade_max[n] = filas[n].profundidade_max;
+    }
+}
+
+/**
+ * Imprime os contadores das duas filas.
+ */
+void registro_relatorio() {
+    registro_stats_t s;
+    registro_get_stats(&s);
+    for (uint n = 0; n < 2; ++n) {
+        printf("[REGISTRO] Nucleo %u: %u escritos, %u perdidos, ocupacao max %u de %u\n", n,
+               (unsigned)s.escritos[n], (unsigned)s.perdidos[n], (unsigned)s.profundidade_max[n],
+               (unsigned)REGISTRO_CAPACIDADE);
+    }
+}
@@ -0,0 +1,94 @@
+#include "lib/tela.h"  // Telas retidas do display
+#include "lib/display_oled.h"
+#include "lib/texto.h"
+#include "lib/grafico.h"
+
+static tela_t *atual = NULL;  // Tela que está no quadro (NULL depois de outro desenho)
+
+// Camada de fundo (só os rótulos) da última tela desenhada do zero
+static uint8_t fundo[DISPLAY_LARGURA * DISPLAY_PAGINAS];
+static tela_t *fundo_de = NULL;
+
+/**
+ * Liga um texto ao widget; só marca o widget se o texto mudou.
+ */
+void tela_texto(tela_t *tela, uint widget, const char *texto) {
+    widget_t *w = &tela->widgets[widget];
+    if (strncmp(w->texto, texto, TELA_TEXTO_MAX - 1) == 0)
+        return;
+    strncpy(w->texto, texto, TELA_TEXTO_MAX - 1);
+    w->texto[TELA_TEXTO_MAX - 1] = '\0';
+    w->alterado = true;
+}
+
+/**
+ * Liga um valor à barra; só marca o widget se mudar o número de pixels acesos.
+ */
+void tela_barra(tela_t *tela, uint widget, float valor) {
+    widget_t *w = &tela->widgets[widget];
+    int interno = w->largura - 2;
+    float fracao = (valor - w->minimo) / (w->maximo - w->minimo);
+    int16_t preenchido = fracao <= 0.f ? 0 : fracao >= 1.f ? interno : (int16_t)(fracao * interno + 0.5f);
+    if (preenchido == w->preenchido)
+        return;
+    w->preenchido = preenchido;
+    w->alterado = true;
+}
+
+/**
+ * Desenha um widget dinâmico na sua caixa (apagada antes).
+ */
+static void desenhar_widget(widget_t *w) {
+    grafico_preencher(&disp, w->x, w->y, w->largura, w->altura, false);
+    if (w->tipo == WIDGET_TEXTO) {
+        texto_desenhar(&disp, w->x, w->y, w->escala, w->texto);
+    } else {
+        grafico_contorno(&disp, w->x, w->y, w->largura - 1, w->altura - 1);
+        grafico_preencher(&disp, w->x + 1, w->y + 1, w->preenchido, w->altura - 2, true);
+    }
+    w->alterado = false;
+}
+
+/**
+ * Leva a tela ao display. Se outra coisa estava no quadro, parte da camada de
+ * fundo (desenhando os rótulos só se ela for de outra tela) e desenha todos os
+ * widgets; senão redesenha só os alterados. Retorna os widgets desenhados.
+ */
+uint tela_mostrar(tela_t *tela) {
+    uint desenhados = 0;
+    bool completa = tela != atual;
+    if (completa) {
+        if (fundo_de != tela) {
+            ssd1306_clear(&disp);
+            for (uint i = 0; i < tela->num_widgets; ++i) {
+                widget_t *w = &tela->widgets[i];
+                if (w->tipo == WIDGET_ROTULO) {
+                    texto_desenhar(&disp, w->x, w->y, w->escala, w->rotulo);
+                    desenhados++;
+                }
+            }
+            memcpy(fundo, disp.buffer, sizeof(fundo));
+            fundo_de = tela;
+        } else {
+            memcpy(disp.buffer, fundo, sizeof(fundo));
+        }
+        atual = tela;
+    }
+
+    for (uint i = 0; i < tela->num_widgets; ++i) {
+        widget_t *w = &tela->widgets[i];
+        if (w->tipo != WIDGET_ROTULO && (completa || w->alterado)) {
+            desenhar_widget(w);
+            desenhados++;
+        }
+    }
+    display_atualizar();
+    return desenhados;
+}
+
+/**
+ * O quadro foi desenhado fora das telas: a próxima tela_mostrar() começa do fundo.
+ */
+void tela_invalidar() {
+    atual = NULL;
+}
@@ -0,0 +1,41 @@
+#ifndef TESTES_CICLOS_H
+#define TESTES_CICLOS_H
+
+// Contador para os benchmarks do PC: ciclos do TSC no x86, nanossegundos
+// nos demais (o nome da unidade sai em CICLOS_UNIDADE)
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CICLOS_UNIDADE "ciclos"
+static inline uint64_t ciclos_agora() {
+    return __rdtsc();
+}
+#else
+#define CICLOS_UNIDADE "ns"
+static inline uint64_t ciclos_agora() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+}
+#endif
+
+/**
+ * Imprime o custo por item no mesmo formato dos benchmarks da placa.
+ */
+static inline void ciclos_imprime(const char *nome, uint64_t ciclos, uint64_t itens, const char *item) {
+    printf("[BENCH] %-28s %.2f %s/%s\n", nome, (double)ciclos / (double)itens, CICLOS_UNIDADE, item);
+}
+
+// Gerador pseudoaleatório dos testes (xorshift64): mesma sequência em toda execução
+static inline uint64_t aleatorio(uint64_t *estado) {
+    uint64_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *estado = x;
+}
+
+#endif // TESTES_CICLOS_H
@@ -0,0 +1,14 @@
+#ifndef TESTES_PICO_STDLIB_H
+#define TESTES_PICO_STDLIB_H
+
+// Substituto do pico/stdlib.h nos testes do PC: só os tipos que os módulos
+// de DSP usam
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+#endif // TESTES_PICO_STDLIB_H
@@ -0,0 +1,120 @@
+// Teste exaustivo do dB em ponto fixo (decibel.c) contra log10 em double:
+// todo x < 2^26, 20 milhões de inteiros de 64 bits e 10 milhões de floats
+// sorteados, mais o benchmark contra log10f.
+#include "lib/decibel.h"
+#include "ciclos.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define EXAUSTIVO_BITS 26
+#define SORTEIOS_INTEIROS 20000000
+#define SORTEIOS_FLOAT 10000000
+#define ERRO_MAX_DB 0.001       // Garantia de lib/decibel.h
+#define BENCH_VALORES 4096
+#define BENCH_REPETICOES 200
+
+static uint falhas = 0;
+
+// Maior erro visto em cada rotina (dB)
+static double erro_mdb = 0.0, erro_log2 = 0.0, erro_float = 0.0;
+
+/**
+ * Confere log2_q16 e potencia_para_mdb para um inteiro.
+ */
+static inline void confere_inteiro(uint64_t x) {
+    double ref = 10.0 * log10((double)x);
+    double erro = fabs(potencia_para_mdb(x) / 1000.0 - ref);
+    if (erro > erro_mdb)
+        erro_mdb = erro;
+    if (erro > ERRO_MAX_DB && falhas++ < 10)
+        printf("potencia_para_mdb(%llu) = %d, esperado %.4f mdB\n", (unsigned long long)x,
+               (int)potencia_para_mdb(x), ref * 1000.0);
+
+    erro = fabs(log2_q16(x) / 65536.0 - log2((double)x)) * 10.0 * log10(2.0);
+    if (erro > erro_log2)
+        erro_log2 = erro;
+    if (erro > ERRO_MAX_DB && falhas++ < 10)
+        printf("log2_q16(%llu) = %d\n", (unsigned long long)x, (int)log2_q16(x));
+}
+
+/**
+ * Confere log2_q16_float para um float positivo e normal.
+ */
+static inline void confere_float(float x) {
+    double erro = fabs(log2_q16_float(x) / 65536.0 - log2((double)x)) * 10.0 * log10(2.0);
+    if (erro > erro_float)
+        erro_float = erro;
+    if (erro > ERRO_MAX_DB && falhas++ < 10)
+        printf("log2_q16_float(%g) = %d\n", x, (int)log2_q16_float(x));
+}
+
+int main() {
+    uint64_t semente = 0x2545F4914F6CDD1Dull;
+
+    // Casos especiais
+    if (potencia_para_mdb(0) != DECIBEL_MDB_ZERO || log2_q16(0) != INT32_MIN ||
+        log2_q16_float(0.f) != INT32_MIN || log2_q16_float(-1.f) != INT32_MIN ||
+        log2_q16_float(1e-40f) != INT32_MIN || log2_q16_para_mdb(INT32_MIN) != DECIBEL_MDB_ZERO) {
+        falhas++;
+        printf("casos especiais (zero, negativo, subnormal) errados\n");
+    }
+
+    // Todos os inteiros até 2^26 (energias e médias quadráticas de blocos típicos)
+    for (uint64_t x = 1; x < (1ull << EXAUSTIVO_BITS); ++x)
+        confere_inteiro(x);
+
+    // Inteiros de 64 bits com o bit mais alto em qualquer posição
+    for (uint i = 0; i < SORTEIOS_INTEIROS; ++i) {
+        uint64_t x = aleatorio(&semente) >> (aleatorio(&semente) & 63);
+        confere_inteiro(x ? x : 1);
+    }
+    confere_inteiro(UINT64_MAX);
+
+    // Floats normais positivos de qualquer expoente
+    for (uint i = 0; i < SORTEIOS_FLOAT; ++i) {
+        uint32_t bits = (uint32_t)aleatorio(&semente) & 0x7FFFFFFFu;
+        float x;
+        memcpy(&x, &bits, sizeof(x));
+        if (!isnormal(x))
+            continue;
+        confere_float(x);
+    }
+    confere_float(1.f);
+    confere_float(FLT_MAX);
+    confere_float(FLT_MIN);
+
+    printf("Erro maximo: potencia_para_mdb %.5f dB, log2_q16 %.6f dB, log2_q16_float %.6f dB\n",
+           erro_mdb, erro_log2, erro_float);
+
+    // Benchmark: dB de médias quadráticas (como na medição) contra 10 * log10f
+    static uint64_t valores[BENCH_VALORES];
+    static float valores_float[BENCH_VALORES];
+    for (uint i = 0; i < BENCH_VALORES; ++i) {
+        valores[i] = (aleatorio(&semente) >> 34) + 1;
+        valores_float[i] = (float)valores[i];
+    }
+    volatile int32_t mdb = 0;
+    volatile float db = 0.f;
+
+    uint64_t inicio = ciclos_agora();
+    for (uint r = 0; r < BENCH_REPETICOES; ++r)
+        for (uint i = 0; i < BENCH_VALORES; ++i)
+            db = 10.f * log10f(valores_float[i]);
+    uint64_t ciclos_log10f = ciclos_agora() - inicio;
+
+    inicio = ciclos_agora();
+    for (uint r = 0; r < BENCH_REPETICOES; ++r)
+        for (uint i = 0; i < BENCH_VALORES; ++i)
+            mdb = potencia_para_mdb(valores[i]);
+    uint64_t ciclos_fixo = ciclos_agora() - inicio;
+
+    ciclos_imprime("10 * log10f", ciclos_log10f, (uint64_t)BENCH_REPETICOES * BENCH_VALORES, "valor");
+    ciclos_imprime("potencia_para_mdb", ciclos_fixo, (uint64_t)BENCH_REPETICOES * BENCH_VALORES, "valor");
+    (void)mdb;
+    (void)db;
+
+    printf("%s: %u falhas\n", falhas ? "FALHOU" : "OK", falhas);
+    return falhas != 0;
+}
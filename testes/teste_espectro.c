@@ -0,0 +1,211 @@
+// Teste do analisador de espectro (espectro.c) contra uma referência em
+// double: a FFT radix-4 em Q15 contra uma FFT em double sobre os mesmos
+// dados, e os níveis das bandas de oitava e 1/3 de oitava contra o mesmo
+// cálculo (janela de Hann, bins com pesos nas bordas, escala 16 / 3N^2)
+// feito em double. Também mede o custo da FFT no PC.
+#include "lib/espectro.h"
+#include "ciclos.h"
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+
+#define TAXA 48000
+#define QUADROS 4                   // Quadros por medição das bandas
+#define AMPLITUDE 8000              // Senoides de teste (formato interno: códigos << 4)
+#define FFT_SNR_MIN_DB 55.0         // Erro da FFT em ponto fixo (~9 bits), também com sinal fraco
+#define BANDA_ERRO_MAX_DB 0.1       // Bandas até BANDA_FAIXA_DB abaixo da mais forte
+#define BANDA_FAIXA_DB 40.0
+#define BENCH_REPETICOES 2000
+
+static uint falhas = 0;
+static espectro_t esp;
+
+/**
+ * FFT em double, radix-2 no lugar (referência).
+ */
+static void fft_double(double complex *x, uint n) {
+    for (uint i = 1, j = 0; i < n; ++i) {
+        uint bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j) {
+            double complex t = x[i];
+            x[i] = x[j];
+            x[j] = t;
+        }
+    }
+    for (uint l = 2; l <= n; l <<= 1) {
+        double complex w = cexp(-2.0 * I * M_PI / l);
+        for (uint g = 0; g < n; g += l) {
+            double complex wk = 1.0;
+            for (uint k = 0; k < l / 2; ++k) {
+                double complex a = x[g + k], b = x[g + k + l / 2] * wk;
+                x[g + k] = a + b;
+                x[g + k + l / 2] = a - b;
+                wk *= w;
+            }
+        }
+    }
+}
+
+/**
+ * Relação sinal/erro (dB) da FFT em ponto fixo para uma entrada real.
+ */
+static double fft_snr(const int16_t *entrada) {
+    static int16_t dados[2 * ESPECTRO_N];
+    static double complex ref[ESPECTRO_N];
+    for (uint i = 0; i < ESPECTRO_N; ++i) {
+        dados[2 * i] = entrada[i];
+        dados[2 * i + 1] = 0;
+        ref[i] = entrada[i];
+    }
+    int32_t expoente = fft_radix4_q15(dados);
+    fft_double(ref, ESPECTRO_N);
+
+    double sinal = 0.0, erro = 0.0;
+    for (uint k = 0; k < ESPECTRO_N; ++k) {
+        double complex x = ldexp(dados[2 * k], expoente) + I * ldexp(dados[2 * k + 1], expoente);
+        sinal += creal(ref[k] * conj(ref[k]));
+        erro += creal((x - ref[k]) * conj(x - ref[k]));
+    }
+    return 10.0 * log10(sinal / erro);
+}
+
+/**
+ * Potência de uma banda [f_ini, f_fim) na referência: bins inteiros e as
+ * frações das bordas (cada bin k cobre [k - 1/2, k + 1/2] * resolução).
+ */
+static double banda_referencia(const double *potencia, double f_ini, double f_fim) {
+    const double resolucao = (double)TAXA / ESPECTRO_N;
+    double b_ini = fmax(f_ini / resolucao, 0.5);
+    double b_fim = fmin(f_fim / resolucao, ESPECTRO_N / 2 - 0.5);
+    double soma = 0.0;
+    for (uint k = 1; k < ESPECTRO_N / 2; ++k) {
+        double sobreposto = fmin(k + 0.5, b_fim) - fmax(k - 0.5, b_ini);
+        if (sobreposto > 0.0)
+            soma += potencia[k] * sobreposto;
+    }
+    return soma;
+}
+
+/**
+ * Compara as bandas de uma medição com a referência; as bandas muito
+ * abaixo da mais forte (só vazamento da janela) ficam de fora.
+ */
+static void confere_bandas(const char *nome, const uint64_t *medido, const double *referencia, uint bandas,
+                           float (*frequencia)(uint), double *erro_max) {
+    double maximo = 0.0;
+    for (uint b = 0; b < bandas; ++b)
+        maximo = fmax(maximo, referencia[b]);
+    for (uint b = 0; b < bandas; ++b) {
+        if (referencia[b] < maximo * pow(10.0, -BANDA_FAIXA_DB / 10.0))
+            continue;
+        double erro = 10.0 * log10((double)medido[b] / referencia[b]);
+        *erro_max = fmax(*erro_max, fabs(erro));
+        if (fabs(erro) > BANDA_ERRO_MAX_DB && falhas++ < 10)
+            printf("%s %.0f Hz: %+.3f dB da referencia\n", nome, frequencia(b), erro);
+    }
+}
+
+/**
+ * Passa QUADROS quadros de um sinal pelo analisador e pela referência.
+ */
+static void confere_sinal(const int32_t *sinal, double *erro_terco, double *erro_oitava) {
+    static double complex x[ESPECTRO_N];
+    static double potencia[ESPECTRO_N / 2];
+    double terco[ESPECTRO_BANDAS_TERCO] = {0}, oitava[ESPECTRO_BANDAS_OITAVA] = {0};
+
+    espectro_reiniciar(&esp);
+    for (uint q = 0; q < QUADROS; ++q) {
+        const int32_t *quadro = &sinal[q * ESPECTRO_N];
+        espectro_adicionar(&esp, quadro, ESPECTRO_N);
+
+        for (uint i = 0; i < ESPECTRO_N; ++i)
+            x[i] = quadro[i] * 0.5 * (1.0 - cos(2.0 * M_PI * i / ESPECTRO_N));
+        fft_double(x, ESPECTRO_N);
+        for (uint k = 0; k < ESPECTRO_N / 2; ++k)
+            potencia[k] = creal(x[k] * conj(x[k]));
+
+        // Média quadrática: soma |X|^2 * 16 / (3 * N^2) por quadro
+        const double escala = 16.0 / (3.0 * ESPECTRO_N * ESPECTRO_N * QUADROS);
+        for (uint b = 0; b < ESPECTRO_BANDAS_TERCO; ++b) {
+            double fc = espectro_frequencia_terco(b);
+            terco[b] += banda_referencia(potencia, fc * pow(10.0, -0.05), fc * pow(10.0, 0.05)) * escala;
+        }
+        for (uint b = 0; b < ESPECTRO_BANDAS_OITAVA; ++b) {
+            double fc = espectro_frequencia_oitava(b);
+            oitava[b] += banda_referencia(potencia, fc * pow(10.0, -0.15), fc * pow(10.0, 0.15)) * escala;
+        }
+    }
+
+    uint64_t medido_terco[ESPECTRO_BANDAS_TERCO], medido_oitava[ESPECTRO_BANDAS_OITAVA];
+    if (espectro_bandas(&esp, medido_terco, medido_oitava) != QUADROS && falhas++ < 10)
+        printf("espectro_bandas: numero de quadros errado\n");
+    confere_bandas("1/3", medido_terco, terco, ESPECTRO_BANDAS_TERCO, espectro_frequencia_terco, erro_terco);
+    confere_bandas("1/1", medido_oitava, oitava, ESPECTRO_BANDAS_OITAVA, espectro_frequencia_oitava, erro_oitava);
+}
+
+int main() {
+    uint64_t semente = 0x853C49E6748FEA9Bull;
+    espectro_init(&esp, TAXA);
+
+    // FFT: ruído cheio, ruído 40 dB abaixo e senoide com ruído
+    static int16_t entrada[ESPECTRO_N];
+    const struct {
+        const char *nome;
+        int32_t amplitude;          // 0: senoide de 1 kHz com ruído
+    } casos[] = {
+        {"ruido cheio", 32767},
+        {"ruido -40 dB", 327},
+        {"senoide + ruido", 0},
+    };
+    for (uint c = 0; c < count_of(casos); ++c) {
+        for (uint i = 0; i < ESPECTRO_N; ++i) {
+            int32_t ruido = (int32_t)(aleatorio(&semente) % 65536) - 32768;
+            if (casos[c].amplitude)
+                entrada[i] = (int16_t)(ruido * casos[c].amplitude / 32768);
+            else
+                entrada[i] = (int16_t)(20000.0 * sin(2.0 * M_PI * 1000.0 * i / TAXA) + ruido / 64);
+        }
+        double snr = fft_snr(entrada);
+        printf("FFT %-16s SNR %.1f dB\n", casos[c].nome, snr);
+        if (snr < FFT_SNR_MIN_DB) {
+            falhas++;
+            printf("FFT %s: SNR abaixo de %.0f dB\n", casos[c].nome, FFT_SNR_MIN_DB);
+        }
+    }
+
+    // Bandas: uma senoide no centro de cada banda de 1/3 de oitava e ruído branco
+    static int32_t sinal[QUADROS * ESPECTRO_N];
+    double erro_terco = 0.0, erro_oitava = 0.0;
+    for (uint b = 0; b < ESPECTRO_BANDAS_TERCO; ++b) {
+        double fc = espectro_frequencia_terco(b);
+        if (fc >= 0.45 * TAXA)
+            continue;
+        for (uint i = 0; i < count_of(sinal); ++i)
+            sinal[i] = (int32_t)lround(AMPLITUDE * sin(2.0 * M_PI * fc * i / TAXA));
+        confere_sinal(sinal, &erro_terco, &erro_oitava);
+    }
+    for (uint i = 0; i < count_of(sinal); ++i)
+        sinal[i] = (int32_t)(aleatorio(&semente) % (2 * AMPLITUDE)) - AMPLITUDE;
+    confere_sinal(sinal, &erro_terco, &erro_oitava);
+    printf("Bandas: maior erro %.3f dB (1/3 de oitava), %.3f dB (oitava)\n", erro_terco, erro_oitava);
+
+    // Custo da FFT por quadro
+    static int16_t dados[2 * ESPECTRO_N];
+    uint64_t ciclos = 0;
+    for (uint r = 0; r < BENCH_REPETICOES; ++r) {
+        for (uint i = 0; i < ESPECTRO_N; ++i) {
+            dados[2 * i] = entrada[i];
+            dados[2 * i + 1] = 0;
+        }
+        uint64_t inicio = ciclos_agora();
+        fft_radix4_q15(dados);
+        ciclos += ciclos_agora() - inicio;
+    }
+    ciclos_imprime("fft_radix4_q15", ciclos, BENCH_REPETICOES, "quadro");
+
+    printf("%s: %u falhas\n", falhas ? "FALHOU" : "OK", falhas);
+    return falhas != 0;
+}
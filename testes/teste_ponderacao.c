@@ -0,0 +1,122 @@
+// Teste da ponderação A/C (ponderacao.c) contra a tabela de tolerâncias
+// classe 1 da IEC 61672-1:2002: uma senoide em cada frequência nominal
+// passa pelo filtro em ponto fixo e o ganho medido, menos a curva
+// analógica do anexo E, precisa caber nos limites. Roda nas três taxas de
+// áudio do projeto, até 0,45 fs (o decimador corta o resto).
+#include "lib/ponderacao.h"
+#include <math.h>
+#include <stdio.h>
+
+#define AMPLITUDE (1000 << 4)   // ~1000 códigos do ADC com AUDIO_FRAC_BITS = 4
+#define BLOCO 480               // Amostras por chamada (como no núcleo 1)
+#define ACOMODACAO_S 1.0        // Tempo descartado antes de medir (transitório dos passa-altas)
+
+// Frequências dos polos (IEC 61672-1, anexo E)
+#define F1 20.598997
+#define F2 107.65265
+#define F3 737.86223
+#define F4 12194.217
+
+// Tabela 2 da IEC 61672-1:2002, classe 1: frequência nominal e limites (dB)
+typedef struct {
+    double nominal;
+    double superior, inferior;
+} tolerancia_t;
+
+static const tolerancia_t tabela[] = {
+    {10, 3.5, -INFINITY}, {12.5, 3.0, -INFINITY}, {16, 2.0, -4.0}, {20, 2.0, -2.0},
+    {25, 2.0, -1.5}, {31.5, 1.5, -1.5}, {40, 1.0, -1.0}, {50, 1.0, -1.0},
+    {63, 1.0, -1.0}, {80, 1.0, -1.0}, {100, 1.0, -1.0}, {125, 1.0, -1.0},
+    {160, 1.0, -1.0}, {200, 1.0, -1.0}, {250, 1.0, -1.0}, {315, 1.0, -1.0},
+    {400, 1.0, -1.0}, {500, 1.0, -1.0}, {630, 1.0, -1.0}, {800, 1.0, -1.0},
+    {1000, 0.7, -0.7}, {1250, 1.0, -1.0}, {1600, 1.0, -1.0}, {2000, 1.0, -1.0},
+    {2500, 1.0, -1.0}, {3150, 1.0, -1.0}, {4000, 1.0, -1.0}, {5000, 1.5, -1.5},
+    {6300, 1.5, -2.0}, {8000, 1.5, -2.5}, {10000, 2.0, -3.0}, {12500, 3.0, -6.0},
+    {16000, 3.5, -17.0}, {20000, 4.0, -INFINITY},
+};
+
+static uint falhas = 0;
+
+/**
+ * Curva analógica do anexo E, sem a normalização em 1 kHz (dB).
+ */
+static double curva(ponderacao_freq_t tipo, double f) {
+    double f2 = f * f;
+    double h = F4 * F4 * f2 / ((f2 + F1 * F1) * (f2 + F4 * F4));
+    if (tipo == PONDERACAO_A)
+        h *= f2 / (sqrt(f2 + F2 * F2) * sqrt(f2 + F3 * F3));
+    return 20.0 * log10(h);
+}
+
+/**
+ * Ganho do filtro em ponto fixo numa frequência (dB): senoide, acomodação e
+ * RMS da saída sobre um número inteiro de períodos (~1 s).
+ */
+static double ganho_medido(ponderacao_freq_t tipo, double f, uint32_t taxa) {
+    static int32_t bloco[BLOCO];
+    filtro_ponderacao_t filtro;
+    ponderacao_init(&filtro, tipo, taxa);
+
+    const uint acomodacao = (uint)(ACOMODACAO_S * taxa);
+    const uint periodos = f < 1.0 ? 1 : (uint)lround(f);
+    const uint medidas = (uint)lround(periodos * taxa / f);
+    double entrada = 0.0, saida = 0.0;
+
+    for (uint n = 0; n < acomodacao + medidas; n += BLOCO) {
+        for (uint i = 0; i < BLOCO; ++i) {
+            bloco[i] = (int32_t)lround(AMPLITUDE * sin(2.0 * M_PI * f * (n + i) / taxa));
+            if (n + i >= acomodacao && n + i < acomodacao + medidas)
+                entrada += (double)bloco[i] * bloco[i];
+        }
+        ponderacao_processar(&filtro, bloco, BLOCO);
+        for (uint i = 0; i < BLOCO; ++i) {
+            if (n + i >= acomodacao && n + i < acomodacao + medidas)
+                saida += (double)bloco[i] * bloco[i];
+        }
+    }
+    return 10.0 * log10(saida / entrada);
+}
+
+/**
+ * Confere uma ponderação numa taxa em todas as frequências da tabela abaixo
+ * de 0,45 fs. Imprime o maior desvio.
+ */
+static void confere(ponderacao_freq_t tipo, uint32_t taxa) {
+    double pior_f = 0.0, pior_desvio = 0.0;
+    for (uint i = 0; i < sizeof(tabela) / sizeof(tabela[0]); ++i) {
+        // Frequência exata da série de base 10 (a nominal é o arredondamento)
+        double f = 1000.0 * pow(10.0, lround(10.0 * log10(tabela[i].nominal / 1000.0)) / 10.0);
+        if (f >= 0.45 * taxa)
+            continue;
+        double desvio = ganho_medido(tipo, f, taxa) - (curva(tipo, f) - curva(tipo, 1000.0));
+        if (desvio > tabela[i].superior || desvio < tabela[i].inferior) {
+            falhas++;
+            printf("%s %u Hz: %g Hz desvio %+.2f dB fora de [%+.1f, %+.1f]\n", ponderacao_nome(tipo),
+                   (unsigned)taxa, tabela[i].nominal, desvio, tabela[i].inferior, tabela[i].superior);
+        }
+        if (fabs(desvio) > fabs(pior_desvio)) {
+            pior_f = tabela[i].nominal;
+            pior_desvio = desvio;
+        }
+    }
+    printf("%s a %u Hz: maior desvio %+.2f dB em %g Hz\n", ponderacao_nome(tipo),
+           (unsigned)taxa, pior_desvio, pior_f);
+}
+
+int main() {
+    static const uint32_t taxas[] = {16000, 32000, 48000};
+    for (uint t = 0; t < sizeof(taxas) / sizeof(taxas[0]); ++t) {
+        confere(PONDERACAO_A, taxas[t]);
+        confere(PONDERACAO_C, taxas[t]);
+
+        // Z passa direto
+        double z = ganho_medido(PONDERACAO_Z, 1000.0, taxas[t]);
+        if (fabs(z) > 1e-6) {
+            falhas++;
+            printf("Z %u Hz: ganho %+.6f dB\n", (unsigned)taxas[t], z);
+        }
+    }
+
+    printf("%s: %u falhas\n", falhas ? "FALHOU" : "OK", falhas);
+    return falhas != 0;
+}
@@ -0,0 +1,125 @@
+// Teste do kernel inteiro de RMS (potencia.c) contra uma referência em
+// double e benchmark das versões float e inteira no PC.
+#include "lib/potencia.h"
+#include "ciclos.h"
+#include <math.h>
+#include <stdio.h>
+
+#define BLOCO 480           // Amostras por bloco a 48 kHz (SAMPLES na placa)
+#define REPETICOES 20000    // Blocos por medição de tempo
+
+static uint falhas = 0;
+
+/**
+ * Confere a raiz inteira: r = piso(sqrt(x)), isto é r^2 <= x < (r+1)^2.
+ */
+static void confere_isqrt(uint64_t x) {
+    unsigned __int128 r = isqrt64(x);
+    if (r * r > x || (r + 1) * (r + 1) <= x) {
+        if (falhas++ < 10)
+            printf("isqrt64(%llu) = %llu\n", (unsigned long long)x, (unsigned long long)r);
+    }
+}
+
+/**
+ * RMS sem DC de referência, em double.
+ */
+static double rms_referencia(const uint16_t *bloco, uint n) {
+    double soma = 0.0;
+    for (uint i = 0; i < n; ++i) {
+        double v = (double)bloco[i] - ADC_BIAS_CODE;
+        soma += v * v;
+    }
+    return sqrt(soma / n);
+}
+
+/**
+ * Compara mic_energy, mic_power_fixed e mic_power com a referência.
+ */
+static void confere_bloco(const uint16_t *bloco, uint n) {
+    uint64_t energia = 0;
+    double com_dc = 0.0;
+    for (uint i = 0; i < n; ++i) {
+        int64_t v = (int64_t)bloco[i] - ADC_BIAS_CODE;
+        energia += (uint64_t)(v * v);
+        com_dc += (double)bloco[i] * bloco[i];
+    }
+    if (mic_energy(bloco, n) != energia && falhas++ < 10)
+        printf("mic_energy(n=%u) = %llu, esperado %llu\n", n,
+               (unsigned long long)mic_energy(bloco, n), (unsigned long long)energia);
+
+    // Q8 truncado: no máximo 1/256 abaixo do valor exato
+    double erro = rms_referencia(bloco, n) - mic_power_fixed(bloco, n) / 256.0;
+    if ((erro < -1e-9 || erro > 1.0 / 256) && falhas++ < 10)
+        printf("mic_power_fixed(n=%u): erro %.6f codigos\n", n, erro);
+
+    // Float com DC: a soma em precisão simples acumula ~n * 2^-24 de erro relativo
+    double ref = sqrt(com_dc / n);
+    if (fabs(mic_power(bloco, n) - ref) > ref * 1e-4 + 1e-6 && falhas++ < 10)
+        printf("mic_power(n=%u) = %.4f, esperado %.4f\n", n, mic_power(bloco, n), ref);
+}
+
+/**
+ * Mesmo bloco do benchmark da placa: senoide de 1 kHz com ruído em torno do bias.
+ */
+static void gera_bloco(uint16_t *bloco, uint n, uint32_t taxa) {
+    uint32_t semente = 12345;
+    for (uint i = 0; i < n; ++i) {
+        semente = semente * 1664525u + 1013904223u;  // LCG
+        int32_t ruido = (int32_t)(semente >> 26) - 32;
+        int32_t seno = (int32_t)(600.f * sinf(2.f * (float)M_PI * 1000.f * i / taxa));
+        bloco[i] = (uint16_t)(ADC_BIAS_CODE + seno + ruido);
+    }
+}
+
+int main() {
+    uint64_t semente = 0x9E3779B97F4A7C15ull;
+
+    // Raiz inteira: todos os valores até 2^22, quadrados e vizinhos, e 10^6 sorteados
+    for (uint64_t x = 0; x < (1u << 22); ++x)
+        confere_isqrt(x);
+    for (uint64_t r = 1; r < (1ull << 32); r = r * 3 + 1) {
+        confere_isqrt(r * r - 1);
+        confere_isqrt(r * r);
+        confere_isqrt(r * r + 1);
+    }
+    confere_isqrt(UINT64_MAX);
+    for (uint i = 0; i < 1000000; ++i)
+        confere_isqrt(aleatorio(&semente) >> (aleatorio(&semente) & 63));
+
+    // Blocos sorteados de todos os tamanhos até BLOCO (restos do laço de 4), e os extremos do ADC
+    static uint16_t bloco[BLOCO];
+    for (uint n = 1; n <= BLOCO; ++n) {
+        for (uint i = 0; i < n; ++i)
+            bloco[i] = (uint16_t)(aleatorio(&semente) & 0xFFF);
+        confere_bloco(bloco, n);
+    }
+    for (uint16_t extremo = 0; extremo <= 4095; extremo += 4095) {
+        for (uint i = 0; i < BLOCO; ++i)
+            bloco[i] = extremo;
+        confere_bloco(bloco, BLOCO);
+    }
+
+    // Benchmark: ciclos por amostra das duas versões
+    gera_bloco(bloco, BLOCO, 48000);
+    volatile float rms_float = 0.f;
+    volatile uint32_t rms_q8 = 0;
+
+    uint64_t inicio = ciclos_agora();
+    for (int r = 0; r < REPETICOES; ++r)
+        rms_float = mic_power(bloco, BLOCO);
+    uint64_t ciclos_float = ciclos_agora() - inicio;
+
+    inicio = ciclos_agora();
+    for (int r = 0; r < REPETICOES; ++r)
+        rms_q8 = mic_power_fixed(bloco, BLOCO);
+    uint64_t ciclos_fixo = ciclos_agora() - inicio;
+
+    ciclos_imprime("mic_power (float)", ciclos_float, (uint64_t)REPETICOES * BLOCO, "amostra");
+    ciclos_imprime("mic_power_fixed (inteiro)", ciclos_fixo, (uint64_t)REPETICOES * BLOCO, "amostra");
+    printf("[BENCH] RMS float (com DC): %.2f, RMS inteiro (sem DC): %.2f codigos\n",
+           rms_float, rms_q8 / 256.f);
+
+    printf("%s: %u falhas\n", falhas ? "FALHOU" : "OK", falhas);
+    return falhas != 0;
+}
@@ -0,0 +1,82 @@
+#include "lib/texto.h"  // Texto rápido no quadro do display
+
+// Fonte embutida do driver (inc/font.h, compilada em inc/ssd1306.c):
+// <altura>, <largura>, <espaço>, <primeiro>, <último> e 5 colunas por glifo
+extern const uint8_t font_8x5[];
+#define FONTE_CABECALHO 5
+#define FONTE_LARGURA 5
+#define FONTE_ESPACO 1
+#define FONTE_PRIMEIRO 32
+#define FONTE_ULTIMO 126
+#define FONTE_GLIFOS (FONTE_ULTIMO - FONTE_PRIMEIRO + 1)
+
+// Colunas esticadas na vertical: bit k da fonte vira os bits k*escala..k*escala+escala-1
+static uint32_t cache[TEXTO_ESCALA_MAX - 1][FONTE_GLIFOS][FONTE_LARGURA];
+static bool cache_pronto[TEXTO_ESCALA_MAX - 1];
+
+/**
+ * Repete cada bit da coluna escala vezes (o bit 0 é a linha de cima).
+ */
+static uint32_t esticar(uint8_t coluna, uint escala) {
+    uint32_t bits = 0;
+    for (int k = 7; k >= 0; --k) {
+        bits <<= escala;
+        if ((coluna >> k) & 1)
+            bits |= (1u << escala) - 1;
+    }
+    return bits;
+}
+
+/**
+ * Monta as colunas esticadas de todos os glifos numa escala.
+ */
+static void preparar_cache(uint escala) {
+    for (uint g = 0; g < FONTE_GLIFOS; ++g)
+        for (uint c = 0; c < FONTE_LARGURA; ++c)
+            cache[escala - 2][g][c] = esticar(font_8x5[FONTE_CABECALHO + g * FONTE_LARGURA + c], escala);
+    cache_pronto[escala - 2] = true;
+}
+
+/**
+ * Soma (OR) uma coluna de até 24 pixels ao quadro a partir de (x, y): com y
+ * alinhado à página cada byte cai inteiro numa página; senão os bits se
+ * dividem entre duas páginas vizinhas. O que passa da última página é cortado.
+ */
+static inline void mesclar_coluna(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t coluna) {
+    uint64_t bits = (uint64_t)coluna << (y & 7);
+    uint8_t *byte = p->buffer + (y >> 3) * p->width + x;
+    for (uint32_t pagina = y >> 3; bits && pagina < p->pages; ++pagina, bits >>= 8, byte += p->width)
+        *byte |= (uint8_t)bits;
+}
+
+/**
+ * Desenha o texto com o canto superior esquerdo em (x, y), com o mesmo
+ * resultado de ssd1306_draw_string(): só acende pixels, e o que passa da
+ * borda é cortado.
+ */
+void texto_desenhar(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t escala, const char *s) {
+    if (escala == 0 || escala > TEXTO_ESCALA_MAX) {
+        ssd1306_draw_string(p, x, y, escala, s);
+        return;
+    }
+    if (y >= p->height)
+        return;
+    if (escala > 1 && !cache_pronto[escala - 2])
+        preparar_cache(escala);
+
+    for (; *s && x < p->width; ++s, x += (FONTE_LARGURA + FONTE_ESPACO) * escala) {
+        uint8_t c = (uint8_t)*s;
+        if (c < FONTE_PRIMEIRO || c > FONTE_ULTIMO)
+            continue;
+        uint g = c - FONTE_PRIMEIRO;
+        for (uint coluna = 0; coluna < FONTE_LARGURA; ++coluna) {
+            uint32_t bits = escala == 1 ? font_8x5[FONTE_CABECALHO + g * FONTE_LARGURA + coluna]
+                                        : cache[escala - 2][g][coluna];
+            if (bits == 0)
+                continue;
+            uint32_t xc = x + coluna * escala;
+            for (uint r = 0; r < escala && xc < p->width; ++r, ++xc)
+                mesclar_coluna(p, xc, y, bits);
+        }
+    }
+}
@@ -0,0 +1,198 @@
+#include "lib/transporte_i2c.h"  // Transporte I2C por DMA
+#include "hardware/dma.h"          // Palavras para a FIFO de transmissão
+#include "hardware/irq.h"          // Interrupção de STOP / abort do I2C
+#include "hardware/sync.h"         // __wfe e seções críticas
+
+static i2c_inst_t *i2c;
+static uint pino_sda, pino_scl;
+static uint32_t baudrate;
+static int canal = -1;
+
+// Transferência em andamento
+static volatile bool ativo = false;
+static uint64_t inicio_us, prazo_us;
+static transporte_i2c_fim_t fim_funcao;
+static void *fim_dados;
+static uint32_t erros_seguidos = 0;
+
+static transporte_i2c_stats_t stats;
+
+/**
+ * (Re)inicia o controlador no baudrate atual e devolve os pinos ao I2C.
+ */
+static void configurar_i2c() {
+    stats.baudrate = i2c_init(i2c, baudrate);
+    gpio_set_function(pino_sda, GPIO_FUNC_I2C);
+    gpio_set_function(pino_scl, GPIO_FUNC_I2C);
+    gpio_pull_up(pino_sda);
+    gpio_pull_up(pino_scl);
+}
+
+/**
+ * Libera um escravo preso no meio de um byte (SDA em 0): até 9 pulsos de
+ * SCL com o SDA solto e um STOP manual, com os pinos em coletor aberto
+ * (saída em 0 puxa a linha, entrada a solta para o pull-up). Depois
+ * reinicia o I2C.
+ */
+static void recuperar_barramento() {
+    dma_channel_abort(canal);
+    i2c_deinit(i2c);
+    gpio_set_function(pino_sda, GPIO_FUNC_SIO);
+    gpio_set_function(pino_scl, GPIO_FUNC_SIO);
+    gpio_put(pino_sda, 0);
+    gpio_put(pino_scl, 0);
+    gpio_set_dir(pino_sda, GPIO_IN);
+    gpio_set_dir(pino_scl, GPIO_IN);
+
+    for (uint i = 0; i < 9 && !gpio_get(pino_sda); ++i) {
+        gpio_set_dir(pino_scl, GPIO_OUT);
+        busy_wait_us(5);
+        gpio_set_dir(pino_scl, GPIO_IN);
+        busy_wait_us(5);
+    }
+    gpio_set_dir(pino_scl, GPIO_OUT);  // STOP: SDA sobe com o SCL alto
+    busy_wait_us(5);
+    gpio_set_dir(pino_sda, GPIO_OUT);
+    busy_wait_us(5);
+    gpio_set_dir(pino_scl, GPIO_IN);
+    busy_wait_us(5);
+    gpio_set_dir(pino_sda, GPIO_IN);
+    busy_wait_us(5);
+
+    configurar_i2c();
+    stats.recuperacoes++;
+}
+
+/**
+ * Fecha a transferência atual. Em erro recupera o barramento e, depois de
+ * TRANSPORTE_I2C_ERROS_FM_PLUS erros seguidos acima de 400 kHz, volta ao
+ * fast mode. Chamada na interrupção ou com as interrupções desligadas.
+ */
+static void concluir(bool ok) {
+    i2c_get_hw(i2c)->intr_mask = 0;
+    uint32_t tempo = (uint32_t)(time_us_64() - inicio_us);
+    stats.transferencias++;
+    stats.tempo_ultimo_us = tempo;
+    if (tempo > stats.tempo_max_us)
+        stats.tempo_max_us = tempo;
+
+    if (ok) {
+        erros_seguidos = 0;
+    } else {
+        stats.erros++;
+        if (baudrate > TRANSPORTE_I2C_HZ && ++erros_seguidos >= TRANSPORTE_I2C_ERROS_FM_PLUS)
+            baudrate = TRANSPORTE_I2C_HZ;
+        recuperar_barramento();
+    }
+    ativo = false;
+    if (fim_funcao)
+        fim_funcao(ok, fim_dados);
+}
+
+/**
+ * Interrupção do I2C: abort encerra com erro; cada STOP fecha uma
+ * transação, e o STOP com o DMA e a FIFO vazios fecha a transferência.
+ */
+static void transporte_i2c_irq() {
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    uint32_t estado = hw->intr_stat;
+    if (estado & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+        dma_channel_abort(canal);
+        (void)hw->clr_tx_abrt;
+        (void)hw->clr_stop_det;
+        if (ativo)
+            concluir(false);
+        return;
+    }
+    if (estado & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+        (void)hw->clr_stop_det;
+        if (ativo && !dma_channel_is_busy(canal) && hw->txflr == 0)
+            concluir(true);
+    }
+}
+
+/**
+ * Configura o I2C nos pinos dados, um canal de DMA e a interrupção. As
+ * escritas bloqueantes do SDK continuam valendo com o transporte parado.
+ */
+void transporte_i2c_init(i2c_inst_t *instancia, uint sda, uint scl, uint32_t frequencia) {
+    i2c = instancia;
+    pino_sda = sda;
+    pino_scl = scl;
+    baudrate = frequencia;
+    configurar_i2c();
+
+    if (canal < 0)
+        canal = dma_claim_unused_channel(true);
+    uint irq = I2C0_IRQ + i2c_hw_index(i2c);
+    irq_set_exclusive_handler(irq, transporte_i2c_irq);
+    irq_set_enabled(irq, true);
+}
+
+/**
+ * Começa a enviar as palavras ao endereço e retorna logo; o buffer precisa
+ * continuar intacto até o fim. Retorna false se houver outra transferência
+ * em andamento. fim (opcional) é chamada na interrupção ao terminar.
+ */
+bool transporte_i2c_enviar(uint8_t endereco, const uint16_t *palavras, uint num_palavras,
+                           transporte_i2c_fim_t fim, void *dados) {
+    if (num_palavras == 0 || transporte_i2c_ocupado())
+        return false;
+
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    hw->enable = 0;
+    hw->tar = endereco;
+    hw->enable = 1;
+    (void)hw->clr_stop_det;
+    (void)hw->clr_tx_abrt;
+
+    fim_funcao = fim;
+    fim_dados = dados;
+    inicio_us = time_us_64();
+    prazo_us = inicio_us + (uint64_t)num_palavras * 9 * 2 * 1000000 / baudrate + TRANSPORTE_I2C_FOLGA_US;
+    stats.bytes += num_palavras;
+    ativo = true;
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+
+    dma_channel_config c = dma_channel_get_default_config(canal);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+    dma_channel_configure(canal, &c, &hw->data_cmd, palavras, num_palavras, true);
+    return true;
+}
+
+/**
+ * Retorna true durante uma transferência. Se o prazo passou sem STOP
+ * (barramento travado), encerra com erro e recupera o barramento.
+ */
+bool transporte_i2c_ocupado() {
+    if (!ativo)
+        return false;
+    if (time_us_64() < prazo_us)
+        return true;
+    uint32_t status = save_and_disable_interrupts();
+    if (ativo)
+        concluir(false);
+    restore_interrupts(status);
+    return false;
+}
+
+/**
+ * Dorme até a transferência atual terminar. Retorna false se ela falhou
+ * por prazo estourado.
+ */
+bool transporte_i2c_esperar() {
+    uint32_t erros = stats.erros;
+    while (transporte_i2c_ocupado())
+        best_effort_wfe_or_timeout(from_us_since_boot(prazo_us));
+    return stats.erros == erros;
+}
+
+/**
+ * Copia os contadores.
+ */
+void transporte_i2c_get_stats(transporte_i2c_stats_t *saida) {
+    *saida = stats;
+}
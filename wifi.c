@@ -3,6 +3,11 @@
 #include "lwip/tcp.h"         // Biblioteca para gerenciar conexões TCP (parte do lwIP)
 #include "lwip/dns.h"         // Biblioteca para resolução de nomes DNS (parte do lwIP)
 #include "lib/wifi.h"         // Possivelmente uma biblioteca personalizada para gerenciar Wi-Fi
+#include "lib/config_flash.h" // Credenciais gravadas na flash (os defines abaixo são o padrão)
+#include "lib/agendador.h"    // Espera dormindo em vez de busy-wait
+#include "lib/energia.h"      // Economia de energia do rádio
+#include "lib/registro.h"     // Registro adiado (os callbacks do lwIP não esperam a USB)
+#include <math.h>             // isfinite
 
 // Configurações do Wi-Fi
 #define WIFI_SSID "HOTSPOTNOTEBOOK"  // Nome da rede Wi-Fi (substitua pelo seu SSID)
@@ -13,6 +18,46 @@
 #define THINGSPEAK_PORT 80                    // Porta HTTP para comunicação
 #define API_KEY "GZ8Y76BXEDG4FVDA"            // Chave de API do ThingSpeak (substitua pela sua)
 
+// O ThingSpeak aceita uma atualização por canal a cada 15 s e recusa as
+// outras sem aviso: o nível e o último evento de microfonia ficam pendentes e
+// saem juntos, numa atualização por janela
+#define THINGSPEAK_INTERVALO_MS 15000
+#define THINGSPEAK_REQUISICOES 2     // Requisições em andamento ao mesmo tempo
+#define THINGSPEAK_CAMPOS_MAX 160
+
+// Requisição HTTP: chave de até CONFIG_VALOR_MAX e campos de até THINGSPEAK_CAMPOS_MAX
+#define THINGSPEAK_REQUISICAO "GET /update?api_key=%s&%s HTTP/1.1\r\n" \
+                              "Host: api.thingspeak.com\r\n" \
+                              "Connection: close\r\n\r\n"
+#define THINGSPEAK_REQUISICAO_MAX (sizeof(THINGSPEAK_REQUISICAO) + CONFIG_VALOR_MAX + THINGSPEAK_CAMPOS_MAX)
+
+// Bandas de oitava de 125 Hz a 4 kHz (índices 2 a 7 de medicao_t.oitava_ddb)
+// nos campos 3 a 8: os dois primeiros são o nível e a microfonia
+#define THINGSPEAK_BANDA_INICIAL 2
+#define THINGSPEAK_BANDAS 6
+
+// Cada requisição leva os seus campos até o callback de conexão do lwIP
+typedef struct {
+    bool em_uso;
+    char campos[THINGSPEAK_CAMPOS_MAX];
+} thingspeak_requisicao_t;
+
+static thingspeak_requisicao_t requisicoes[THINGSPEAK_REQUISICOES];
+
+// Valores aguardando a próxima janela de envio
+static bool nivel_pendente = false;
+static float nivel_db;
+static bool microfonia_pendente = false;
+static float microfonia_hz;
+static bool bandas_pendentes = false;
+static int16_t bandas_ddb[THINGSPEAK_BANDAS];
+static absolute_time_t proximo_envio = 0;
+
+// Credenciais em uso: da flash, se gravadas, ou os defines acima
+static char wifi_ssid[33];
+static char wifi_senha[CONFIG_VALOR_MAX + 1];
+static char api_key[CONFIG_VALOR_MAX + 1];
+
 // Variável para controlar o estado da conexão Wi-Fi
 bool wifi_connected = false;
 
@@ -24,15 +69,9 @@ static uint32_t last_check_time = 0;              // Armazena o tempo da última
 static const uint32_t CHECK_INTERVAL_MS = 10000;  // Intervalo de verificação (10 segundos)
 
 
-// Função de temporizador em segundos
+// Função de temporizador em segundos (o núcleo dorme até o alarme)
 void timer_seconds(int seconds) {
-    uint64_t start_time = time_us_64(); // Obtém o tempo atual em microssegundos
-    uint64_t delay = seconds * 1000000; // Converte segundos para microssegundos
-
-    // Aguarda até que o tempo especificado tenha passado
-    while (time_us_64() - start_time < delay) {
-        // Loop vazio (busy-wait)
-    }
+    agendador_dormir_us((uint64_t)seconds * 1000000);
 }
 
 /**
@@ -49,56 +88,121 @@ static bool should_check() {
 }
 
 /**
- * Temporizador: Funcao para inicializar o WiFi com tentativas repetidas.
+ * Lê da flash as credenciais do Wi-Fi e a chave do ThingSpeak (ou usa os padrões).
+ */
+static void wifi_ler_credenciais() {
+    config_ler_texto(CONFIG_WIFI_SSID, wifi_ssid, sizeof(wifi_ssid), WIFI_SSID);
+    config_ler_texto(CONFIG_WIFI_SENHA, wifi_senha, sizeof(wifi_senha), WIFI_PASS);
+    config_ler_texto(CONFIG_THINGSPEAK_CHAVE, api_key, sizeof(api_key), API_KEY);
+}
+
+/**
+ * Marca o Wi-Fi como conectado e aplica o modo de energia do rádio.
+ */
+static void wifi_conexao_pronta() {
+    printf("[INFO] Conectado ao WiFi!\n");
+    printf("Endereço IP: %s\n", ip4addr_ntoa(netif_ip4_addr(netif_default)));
+    wifi_connected = true;
+    wifi_set_modo_energia(energia_baixo_consumo() ? ENERGIA_WIFI_MODO_ECONOMIA : ENERGIA_WIFI_MODO_PADRAO);
+}
+
+/**
+ * Liga o rádio e começa a conectar sem esperar: o andamento é conferido por
+ * wifi_verificar_conexao(), e a associação avança em cyw43_arch_poll().
  */
-bool inicializar_wifi() {
+bool wifi_iniciar_conexao() {
     if (cyw43_arch_init()) {
         printf("[ERRO] Erro ao inicializar o WiFi\n");
         return false;
     }
+    energia_wifi(ENERGIA_WIFI_MODO_PADRAO);
     cyw43_arch_enable_sta_mode();
 
-    if (!connect_to_wifi()) {
-        printf("[ERRO] Falha ao conectar ao WiFi.\n");
+    wifi_ler_credenciais();
+    printf("[INFO] Conectando ao WiFi %s...\n", wifi_ssid);
+    if (cyw43_arch_wifi_connect_async(wifi_ssid, wifi_senha, CYW43_AUTH_WPA2_AES_PSK)) {
+        printf("[ERRO] Erro ao conectar ao WiFi\n");
         return false;
     }
-
-    printf("[INFO] WiFi conectado com sucesso!\n");
     return true;
 }
 
+/**
+ * Andamento da conexão iniciada por wifi_iniciar_conexao(). Na primeira vez
+ * que o link sobe, marca o Wi-Fi como conectado.
+ */
+wifi_conexao_t wifi_verificar_conexao() {
+    int link = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+    if (link == CYW43_LINK_UP) {
+        if (!wifi_connected)
+            wifi_conexao_pronta();
+        return WIFI_CONEXAO_PRONTA;
+    }
+    if (link == CYW43_LINK_FAIL || link == CYW43_LINK_NONET || link == CYW43_LINK_BADAUTH)
+        return WIFI_CONEXAO_FALHOU;
+    return WIFI_CONEXAO_ANDAMENTO;
+}
+
+/**
+ * Devolve a requisição ao conjunto livre.
+ */
+static void requisicao_liberar(thingspeak_requisicao_t *req) {
+    if (req)
+        req->em_uso = false;
+}
+
+/**
+ * Callback de erro do lwIP (conexão recusada, abortada ou sem resposta): a
+ * conexão já foi liberada pelo lwIP, falta só a requisição.
+ */
+static void tcp_err_callback(void *arg, err_t err) {
+    REGISTRO(REG_ENVIO_ERRO_CONEXAO);
+    requisicao_liberar((thingspeak_requisicao_t *)arg);
+}
 
 /**
  * Callback chamado quando os dados são enviados com sucesso ao servidor.
  */
 static err_t tcp_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len) {
-    printf("[DADOS] Dados enviados com sucesso!\n");
+    REGISTRO(REG_ENVIO_OK);
+    tcp_arg(tpcb, NULL);  // Um erro depois do fechamento não libera a requisição de novo
+    requisicao_liberar((thingspeak_requisicao_t *)arg);
     tcp_close(tpcb);  // Fecha a conexão TCP após o envio
     return ERR_OK;
 }
 
 /**
  * Callback chamado quando a conexão TCP com o servidor é estabelecida.
+ * arg aponta para a requisição, com os campos (ex.: "field1=55.20").
  */
 static err_t tcp_connected_callback(void *arg, struct tcp_pcb *tpcb, err_t err) {
     if (err == ERR_OK) {
-        printf("[INFO] Conectado ao servidor!\n");
+        REGISTRO(REG_ENVIO_CONECTADO);
 
-        // Prepara a requisição HTTP GET com o valor de dB atual
-        float db_level = current_db_level;
-        char request[200];
-        snprintf(request, sizeof(request),
-                 "GET /update?api_key=%s&field1=%.2f HTTP/1.1\r\n"
-                 "Host: api.thingspeak.com\r\n"
-                 "Connection: close\r\n\r\n",
-                 API_KEY, db_level);
+        // Prepara a requisição HTTP GET com os campos do envio (os callbacks
+        // do lwIP não se sobrepõem, e tcp_write copia: o buffer pode ser estático)
+        const char *campos = ((thingspeak_requisicao_t *)arg)->campos;
+        static char request[THINGSPEAK_REQUISICAO_MAX];
+        int tamanho = snprintf(request, sizeof(request), THINGSPEAK_REQUISICAO, api_key, campos);
+        if (tamanho < 0 || (size_t)tamanho >= sizeof(request)) {
+            // Cortada, a requisição perderia o fim do cabeçalho: melhor não enviar
+            REGISTRO(REG_ENVIO_ERRO_TAMANHO, (uint32_t)tamanho, sizeof(request));
+            tcp_arg(tpcb, NULL);
+            requisicao_liberar((thingspeak_requisicao_t *)arg);
+            tcp_abort(tpcb);
+            return ERR_ABRT;
+        }
 
         // Envia a requisição ao servidor
-        tcp_write(tpcb, request, strlen(request), TCP_WRITE_FLAG_COPY);
+        tcp_write(tpcb, request, (u16_t)tamanho, TCP_WRITE_FLAG_COPY);
         tcp_output(tpcb);  // Força o envio dos dados
         tcp_sent(tpcb, tcp_sent_callback);  // Configura o callback para pós-envio
     } else {
-        printf("[ERRO] Falha ao conectar ao servidor\n");
+        REGISTRO(REG_ENVIO_ERRO_CONEXAO);
+        tcp_arg(tpcb, NULL);
+        requisicao_liberar((thingspeak_requisicao_t *)arg);
+        tcp_abort(tpcb);
+        return ERR_ABRT;
     }
     return ERR_OK;
 }
@@ -108,60 +212,162 @@ static err_t tcp_connected_callback(void *arg, struct tcp_pcb *tpcb, err_t err)
  */
 static void dns_resolve_callback(const char *name, const ip_addr_t *ipaddr, void *arg) {
     if (ipaddr != NULL) {
-        printf("[INFO] Endereço IP do ThingSpeak resolvido: %s\n", ipaddr_ntoa(ipaddr));
+        uint32_t ip = ip4_addr_get_u32(ip_2_ip4(ipaddr));  // Ordem de rede: primeiro octeto no byte baixo
+        REGISTRO(REG_ENVIO_DNS, ip & 0xFF, (ip >> 8) & 0xFF, (ip >> 16) & 0xFF, ip >> 24);
 
         // Cria uma nova conexão TCP
         struct tcp_pcb *pcb = tcp_new();
         if (!pcb) {
-            printf("[ERRO] Erro ao criar conexão TCP\n");
+            REGISTRO(REG_ENVIO_ERRO_TCP);
+            requisicao_liberar((thingspeak_requisicao_t *)arg);
             return;
         }
 
-        // Tenta conectar ao servidor ThingSpeak
-        tcp_connect(pcb, ipaddr, THINGSPEAK_PORT, tcp_connected_callback);
+        // Tenta conectar ao servidor ThingSpeak, levando a requisição até os callbacks
+        tcp_arg(pcb, arg);
+        tcp_err(pcb, tcp_err_callback);
+        if (tcp_connect(pcb, ipaddr, THINGSPEAK_PORT, tcp_connected_callback) != ERR_OK) {
+            REGISTRO(REG_ENVIO_ERRO_TCP);
+            tcp_arg(pcb, NULL);
+            tcp_abort(pcb);
+            requisicao_liberar((thingspeak_requisicao_t *)arg);
+        }
     } else {
-        printf("[ERRO] Erro na resolução de DNS\n");
+        REGISTRO(REG_ENVIO_ERRO_DNS);
+        requisicao_liberar((thingspeak_requisicao_t *)arg);
     }
 }
 
 /**
- * Envia os dados de dB para o ThingSpeak.
+ * Inicia a requisição (DNS, conexão e GET nos callbacks do lwIP). A
+ * requisição é liberada pelos callbacks, ou aqui se o DNS falhar na hora.
  */
-bool send_data_to_thingspeak(float db_level) {
-    if (!wifi_connected) {
-        printf("[INFO] WiFi desconectado. Não é possível enviar dados.\n");
-        return false;
-    }
+static bool thingspeak_enviar(thingspeak_requisicao_t *req) {
+    REGISTRO(REG_ENVIO_INICIO);
 
     // Inicia a resolução DNS do host do ThingSpeak
     ip_addr_t server_ip;
     cyw43_arch_lwip_begin();
-    err_t err = dns_gethostbyname(THINGSPEAK_HOST, &server_ip, dns_resolve_callback, NULL);
+    err_t err = dns_gethostbyname(THINGSPEAK_HOST, &server_ip, dns_resolve_callback, req);
+    if (err == ERR_OK) {
+        dns_resolve_callback(THINGSPEAK_HOST, &server_ip, req);  // Endereço já estava no cache
+    } else if (err != ERR_INPROGRESS) {
+        REGISTRO(REG_ENVIO_ERRO_DNS);
+        requisicao_liberar(req);
+    }
     cyw43_arch_lwip_end();
 
-    if (err != ERR_OK) {
-        return true;
+    return err == ERR_OK || err == ERR_INPROGRESS;
+}
+
+/**
+ * Envia numa só atualização o que estiver pendente, se a janela do
+ * ThingSpeak já passou e houver uma requisição livre; senão os valores
+ * esperam a próxima chamada.
+ */
+static bool thingspeak_despachar() {
+    if (!nivel_pendente && !microfonia_pendente)
+        return false;
+    if (!wifi_connected) {
+        REGISTRO(REG_ENVIO_SEM_WIFI);
+        return false;
+    }
+    if (!time_reached(proximo_envio))
+        return false;
+
+    thingspeak_requisicao_t *req = NULL;
+    for (uint i = 0; i < THINGSPEAK_REQUISICOES && !req; ++i) {
+        if (!requisicoes[i].em_uso)
+            req = &requisicoes[i];
     }
+    if (!req)
+        return false;  // As anteriores ainda estão em andamento
 
-    printf("[INFO] Iniciando envio de dados para o ThingSpeak...\n");
+    int n = 0;
+    req->campos[0] = '\0';
+    if (nivel_pendente)
+        n += snprintf(req->campos, sizeof(req->campos), "field1=%.2f", nivel_db);
+    if (microfonia_pendente)
+        n += snprintf(req->campos + n, sizeof(req->campos) - n, "%sfield2=%.1f&status=Microfonia+em+%.0f+Hz",
+                      n ? "&" : "", microfonia_hz, microfonia_hz);
+    for (uint b = 0; bandas_pendentes && b < THINGSPEAK_BANDAS; ++b)
+        n += snprintf(req->campos + n, sizeof(req->campos) - n, "%sfield%u=%.1f",
+                      n ? "&" : "", 3 + b, bandas_ddb[b] / 10.f);
+    req->em_uso = true;
+    nivel_pendente = microfonia_pendente = bandas_pendentes = false;
+    proximo_envio = make_timeout_time_ms(THINGSPEAK_INTERVALO_MS);
+    return thingspeak_enviar(req);
 }
 
 /**
- * Conecta ao Wi-Fi usando as credenciais fornecidas.
+ * Envia os dados de dB para o ThingSpeak (campo 1). Dentro da janela de 15 s
+ * fica só o valor mais recente, enviado na próxima atualização. Sem medição
+ * válida o nível é -inf, que o ThingSpeak recusa: nesse caso o campo 1 fica
+ * de fora.
+ */
+bool send_data_to_thingspeak(float db_level) {
+    if (!isfinite(db_level))
+        return thingspeak_despachar();  // Ainda pode haver microfonia pendente
+    nivel_db = db_level;
+    nivel_pendente = true;
+    return thingspeak_despachar();
+}
+
+/**
+ * Publica um evento de microfonia no ThingSpeak: frequência no campo 2 e
+ * o aviso no status do canal. Os eventos de uma mesma janela de 15 s se
+ * juntam: vai o último, com o nível, na próxima atualização.
+ */
+bool send_feedback_to_thingspeak(float frequencia) {
+    microfonia_hz = frequencia;
+    microfonia_pendente = true;
+    return thingspeak_despachar();
+}
+
+/**
+ * Guarda as bandas de oitava da medição (0,1 dB, a partir de 31,5 Hz) para
+ * os campos 3 a 8 (125 Hz a 4 kHz). Não dispara o envio: elas saem junto
+ * com o nível na próxima atualização.
+ */
+void send_bands_to_thingspeak(const int16_t *oitava_ddb) {
+    memcpy(bandas_ddb, &oitava_ddb[THINGSPEAK_BANDA_INICIAL], sizeof(bandas_ddb));
+    bandas_pendentes = true;
+}
+
+/**
+ * Conecta ao Wi-Fi usando as credenciais fornecidas (bloqueia até 10 s).
  */
 bool connect_to_wifi() {
-    printf("[INFO] Conectando ao WiFi...\n");
-    if (cyw43_arch_wifi_connect_timeout_ms(WIFI_SSID, WIFI_PASS, CYW43_AUTH_WPA2_AES_PSK, 10000)) {
+    wifi_ler_credenciais();
+    printf("[INFO] Conectando ao WiFi %s...\n", wifi_ssid);
+    if (cyw43_arch_wifi_connect_timeout_ms(wifi_ssid, wifi_senha, CYW43_AUTH_WPA2_AES_PSK, 10000)) {
         printf("[ERRO] Erro ao conectar ao WiFi\n");
         wifi_connected = false;
         return false;
     }
-    printf("[INFO] Conectado ao WiFi!\n");
-    printf("Endereço IP: %s\n", ip4addr_ntoa(netif_ip4_addr(netif_default)));
-    wifi_connected = true;
+    wifi_conexao_pronta();
     return true;
 }
 
+/**
+ * Escolhe o modo de economia de energia do CYW43: desempenho (rádio
+ * sempre ligado, menor latência), o padrão do driver ou economia agressiva
+ * (o rádio dorme entre os beacons; latência de centenas de ms).
+ */
+void wifi_set_modo_energia(energia_wifi_t modo) {
+    static const uint32_t pm[] = {
+        [ENERGIA_WIFI_MODO_DESEMPENHO] = CYW43_PERFORMANCE_PM,
+        [ENERGIA_WIFI_MODO_PADRAO] = CYW43_DEFAULT_PM,
+        [ENERGIA_WIFI_MODO_ECONOMIA] = CYW43_AGGRESSIVE_PM,
+    };
+    if (modo == ENERGIA_WIFI_DESLIGADO || !wifi_connected)
+        return;
+    cyw43_arch_lwip_begin();
+    cyw43_wifi_pm(&cyw43_state, pm[modo]);
+    cyw43_arch_lwip_end();
+    energia_wifi(modo);
+}
+
 /**
  * Função principal de monitoramento.
  * Executa um loop infinito para verificar e enviar dados periodicamente.